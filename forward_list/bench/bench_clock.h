@@ -0,0 +1,21 @@
+/**
+ *  @brief Wall clock timing shared by the benchmarks.
+ *
+ *  @file bench_clock.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_BENCH_CLOCK
+#define FORWARD_LIST_BENCH_CLOCK
+
+#include <time.h>
+
+/* Seconds elapsed on a monotonic clock. */
+static double bench_now(void)
+{
+    struct timespec __t;
+    clock_gettime(CLOCK_MONOTONIC, &__t);
+    return __t.tv_sec + __t.tv_nsec * 1e-9;
+}
+
+#endif
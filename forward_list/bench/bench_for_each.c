@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "../include/forward_list.h"
+#include "bench_clock.h"
+
+/* Usage: bench_for_each [nodes] */
+
+#define ROUNDS 5
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const uint64_t*) __x > *(const uint64_t*) __y;
+}
+
+static void add(void* __value, void* __ctx)
+{
+    *(uint64_t*) __ctx += *(const uint64_t*) __value;
+}
+
+/*
+ * Heap list of pseudo random keys, sorted so that list order no longer
+ * follows allocation order and every step of a walk lands on an
+ * unrelated cache line.
+ */
+static Forward_List scattered(size_t __n)
+{
+    Forward_List __list = FWL_Init(sizeof(uint64_t));
+    uint64_t __x = 88172645463325252ull;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __x ^= __x << 13;
+        __x ^= __x >> 7;
+        __x ^= __x << 17;
+        FWL_push_back(uint64_t, &__list, __x);
+    }
+    FWL_sort(&__list, greater);
+    return __list;
+}
+
+static uint64_t walk_plain(Forward_List* __list)
+{
+    uint64_t __sum = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next)
+    {
+        __sum += FWL_cast(uint64_t, __it);
+    }
+    return __sum;
+}
+
+static uint64_t walk_for_each(Forward_List* __list)
+{
+    uint64_t __sum = 0;
+    FWL_for_each(__list, add, &__sum);
+    return __sum;
+}
+
+/* Best of ROUNDS walks, in nanoseconds per node. */
+static double measure(Forward_List* __list, uint64_t (*__walk)(Forward_List *), uint64_t* __sum)
+{
+    double __best = 1e30;
+    for (int __r = 0; __r < ROUNDS; ++__r)
+    {
+        double __start = bench_now();
+        *__sum = __walk(__list);
+        double __elapsed = bench_now() - __start;
+        __best = __elapsed < __best ? __elapsed : __best;
+    }
+    return __best * 1e9 / FWL_size(__list);
+}
+
+int main(int argc, char** argv)
+{
+    size_t __n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000;
+    Forward_List __list = scattered(__n);
+    uint64_t __plain_sum = 0;
+    uint64_t __sum = 0;
+    printf("%zu scattered heap nodes, best of %d walks\n", __n, ROUNDS);
+    printf("plain it->next loop          %6.2f ns/node\n", measure(&__list, walk_plain, &__plain_sum));
+    printf("FWL_for_each                 %6.2f ns/node\n", measure(&__list, walk_for_each, &__sum));
+    if(__sum != __plain_sum)
+    {
+        printf("%s", "bench_for_each: sums differ\n");
+        return EXIT_FAILURE;
+    }
+    for (size_t __stride = 1; __stride <= 16; __stride *= 4)
+    {
+        FWL_enable_index(&__list, __stride);
+        FWL_at(&__list, 0);
+        printf("FWL_for_each, index stride %2zu %6.2f ns/node\n", __stride, measure(&__list, walk_for_each, &__sum));
+    }
+    FWL_clear(&__list);
+    return 0;
+}
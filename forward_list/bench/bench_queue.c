@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../include/forward_list.h"
+#include "../include/forward_list_queue.h"
+#include "bench_clock.h"
+
+/*
+ * Usage: bench_queue [messages]
+ *
+ * Throughput of Forward_List_Queue against the Forward_List guarded by
+ * a mutex it replaces, with one producer (SPSC) and with PRODUCERS
+ * producers (MPSC), and one consumer.
+ */
+#define PRODUCERS 4
+#define CAPACITY 1024
+
+enum Kind { LOCKED, QUEUE };
+
+static struct
+{
+    enum Kind kind;
+    size_t per_producer;
+    pthread_mutex_t lock;
+    Forward_List locked;
+    Forward_List_Queue queue;
+} bench;
+
+static void* produce(void* __arg)
+{
+    uint64_t __base = (uint64_t) (uintptr_t) __arg * bench.per_producer;
+    for (uint64_t __i = 0; __i < bench.per_producer; ++__i)
+    {
+        if(bench.kind == LOCKED)
+        {
+            pthread_mutex_lock(&bench.lock);
+            FWL_push_back(uint64_t, &bench.locked, __base + __i);
+            pthread_mutex_unlock(&bench.lock);
+        }
+        else
+        {
+            while(!FWLQ_push(uint64_t, &bench.queue, __base + __i))
+            {
+                sched_yield();
+            }
+        }
+    }
+    return NULL;
+}
+
+/* Pops __total messages and returns their sum. */
+static uint64_t consume(size_t __total)
+{
+    uint64_t __sum = 0;
+    for (size_t __n = 0; __n < __total; )
+    {
+        uint64_t __value = 0;
+        int __got = 0;
+        if(bench.kind == LOCKED)
+        {
+            pthread_mutex_lock(&bench.lock);
+            if(!FWL_empty(&bench.locked))
+            {
+                __value = FWL_front(uint64_t, &bench.locked);
+                FWL_pop_front(&bench.locked);
+                __got = 1;
+            }
+            pthread_mutex_unlock(&bench.lock);
+        }
+        else
+        {
+            __got = FWLQ_pop(&bench.queue, &__value);
+        }
+        if(__got)
+        {
+            __sum += __value;
+            ++__n;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    return __sum;
+}
+
+static void run(const char* __name, enum Kind __kind, size_t __producers, size_t __messages)
+{
+    bench.kind = __kind;
+    bench.per_producer = __messages / __producers;
+    size_t __total = bench.per_producer * __producers;
+    pthread_mutex_init(&bench.lock, NULL);
+    bench.locked = FWL_Init(sizeof(uint64_t));
+    FWLQ_Init(&bench.queue, sizeof(uint64_t), CAPACITY);
+
+    pthread_t __threads[PRODUCERS];
+    double __start = bench_now();
+    for (size_t __i = 0; __i < __producers; ++__i)
+    {
+        pthread_create(&__threads[__i], NULL, produce, (void*) (uintptr_t) __i);
+    }
+    uint64_t __sum = consume(__total);
+    for (size_t __i = 0; __i < __producers; ++__i)
+    {
+        pthread_join(__threads[__i], NULL);
+    }
+    double __elapsed = bench_now() - __start;
+    if(__sum != (uint64_t) __total * (__total - 1) / 2)
+    {
+        printf("%s", "bench_queue: messages lost\n");
+        exit(EXIT_FAILURE);
+    }
+    printf("%-28s %zu producer(s) %8.2f M msg/s\n", __name, __producers, __total / __elapsed / 1e6);
+    FWLQ_Destroy(&bench.queue);
+    FWL_clear(&bench.locked);
+    pthread_mutex_destroy(&bench.lock);
+}
+
+int main(int argc, char** argv)
+{
+    size_t __messages = argc > 1 ? strtoul(argv[1], NULL, 10) : 4000000;
+    printf("%zu messages, capacity %d\n", __messages, CAPACITY);
+    for (size_t __producers = 1; __producers <= PRODUCERS; __producers *= PRODUCERS)
+    {
+        run("mutex + Forward_List", LOCKED, __producers, __messages);
+        run("FWLQ_push / FWLQ_pop", QUEUE, __producers, __messages);
+    }
+    return 0;
+}
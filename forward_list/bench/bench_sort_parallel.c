@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include "../include/forward_list.h"
+#include "bench_clock.h"
+
+/* Usage: bench_sort_parallel [nodes] */
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const uint64_t*) __x > *(const uint64_t*) __y;
+}
+
+/* Fills the list with the same pseudo random keys for every run. */
+static void fill(Forward_List* __list, size_t __n)
+{
+    uint64_t __x = 88172645463325252ull;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __x ^= __x << 13;
+        __x ^= __x >> 7;
+        __x ^= __x << 17;
+        FWL_push_back(uint64_t, __list, __x);
+    }
+}
+
+static void check_sorted(Forward_List* __list)
+{
+    for (FWL_iterator __it = FWL_begin(__list); __it && __it->next; __it = __it->next)
+    {
+        if(greater(__it->storage, __it->next->storage))
+        {
+            printf("%s", "bench_sort_parallel: list not sorted\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    size_t __n = argc > 1 ? strtoul(argv[1], NULL, 10) : 2000000;
+    printf("%zu nodes, %ld online cpus\n", __n, sysconf(_SC_NPROCESSORS_ONLN));
+
+    /*
+     * Releasing a sorted list shuffles the free memory of the allocator,
+     * so one sort is run first and every measured run gets nodes laid out
+     * alike, scattered as in a long lived list.
+     */
+    Forward_List __list = FWL_Init(sizeof(uint64_t));
+    fill(&__list, __n);
+    FWL_sort(&__list, greater);
+    FWL_clear(&__list);
+
+    fill(&__list, __n);
+    double __start = bench_now();
+    FWL_sort(&__list, greater);
+    double __sequential = bench_now() - __start;
+    check_sorted(&__list);
+    FWL_clear(&__list);
+    printf("FWL_sort             %8.3f s\n", __sequential);
+
+    for (size_t __threads = 1; __threads <= 8; __threads *= 2)
+    {
+        fill(&__list, __n);
+        __start = bench_now();
+        FWL_sort_parallel(&__list, greater, __threads);
+        double __elapsed = bench_now() - __start;
+        check_sorted(&__list);
+        FWL_clear(&__list);
+        printf("FWL_sort_parallel %zu  %8.3f s  speedup %.2fx\n", __threads, __elapsed, __sequential / __elapsed);
+    }
+    return 0;
+}
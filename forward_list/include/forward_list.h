@@ -22,6 +22,9 @@
 #ifndef FORWARD_LIST
 #define FORWARD_LIST
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef unsigned char Forward_List_Generic;
 
 struct Forward_List_Node
@@ -33,16 +36,97 @@ struct Forward_List_Node
 typedef struct Forward_List_Node  Forward_List_Node;
 typedef struct Forward_List_Node* FWL_iterator;
 
+/**
+ *  Link field embedded in user structures linked by an intrusive
+ *  %forward_list, see FWL_Init_intrusive(). It has the layout of a
+ *  Forward_List_Node without storage.
+ */
+struct Forward_List_Link
+{
+    struct Forward_List_Node* next;
+};
+
+typedef struct Forward_List_Link Forward_List_Link;
+
+/**
+ *  Where the nodes of a %forward_list come from.
+ *
+ *  FWL_ALLOC_HEAP   One calloc()/free() per node (the default).
+ *  FWL_ALLOC_ARENA  Nodes are carved from large per-list slabs and
+ *                   released nodes are kept on an internal free list.
+ *  FWL_ALLOC_POOL   Nodes are shared by every pooled %forward_list of the
+ *                   same element size through per-thread caches.
+ *  FWL_ALLOC_NONE   Nodes are links embedded in user structures, the
+ *                   %forward_list never allocates nor frees them.
+ */
+typedef enum Forward_List_Allocator
+{
+    FWL_ALLOC_HEAP,
+    FWL_ALLOC_ARENA,
+    FWL_ALLOC_POOL,
+    FWL_ALLOC_NONE
+} Forward_List_Allocator;
+
+struct Forward_List_Arena
+{
+    void* slabs;                    /* Chain of slabs, newest first. */
+    Forward_List_Node* free_nodes;  /* Released nodes ready for reuse. */
+    Forward_List_Generic* bump;     /* Next never used node in the newest slab. */
+    Forward_List_Generic* bump_end; /* One past the last node of the newest slab. */
+    size_t slab_nodes;              /* Number of nodes in each slab. */
+};
+
+typedef struct Forward_List_Arena Forward_List_Arena;
+
+/* Node pointers kept on demand, see FWL_enable_index(). */
+struct Forward_List_Index
+{
+    Forward_List_Node** nodes;      /* nodes[i] is the node at position i * stride. */
+    size_t length;                  /* Entries in use. */
+    size_t capacity;                /* Entries allocated. */
+    size_t stride;                  /* Positions between entries, 0 when disabled. */
+    int valid;                      /* Cleared whenever the list is reshaped. */
+};
+
+typedef struct Forward_List_Index Forward_List_Index;
+
+/* Skip list kept above the nodes of a sorted list, see FWL_enable_sorted(). */
+struct Forward_List_Skip
+{
+    void* head;                     /* Tower heading every level. */
+    int (*compare)(const void *, const void *);
+    uint64_t seed;                  /* State of the tower height generator. */
+    size_t levels;                  /* Levels in use. */
+    int valid;                      /* Cleared whenever nodes are removed or moved. */
+};
+
+typedef struct Forward_List_Skip Forward_List_Skip;
+
 struct Forward_List
 {
     Forward_List_Node* start;
     Forward_List_Node* finish;
     size_t count;
     size_t size;
+    ptrdiff_t offset;               /* Element address minus node address. */
+    Forward_List_Allocator allocator;
+    Forward_List_Arena arena;
+    Forward_List_Index index;
+    Forward_List_Skip skip;
 };
 
 typedef struct Forward_List Forward_List;
 
+/* Counters of the process-wide node pool, see FWL_pool_stats(). */
+struct Forward_List_Pool_Stats
+{
+    size_t hits;    /* Nodes served from a cache of the pool. */
+    size_t misses;  /* Nodes the pool had to calloc(). */
+    size_t cached;  /* Nodes currently parked in the shared depot. */
+};
+
+typedef struct Forward_List_Pool_Stats Forward_List_Pool_Stats;
+
 /**
   * @brief  Initializes the %forward_list.
   * @param _Tp   Type of the data to be stored in the %forward_list.
@@ -55,9 +139,7 @@ typedef struct Forward_List Forward_List;
    _Tp __buffer[] = __VA_ARGS__;                     \
     size_t __size = sizeof(__buffer)/sizeof(_Tp);    \
     Forward_List __list = FWL_Init(sizeof(_Tp));     \
-    for (size_t __i = 0; __i < __size; ++__i){       \
-        FWL_push_back(_Tp, &__list, __buffer[__i]);  \
-    }                                                \
+    FWL_from_array(&__list, __buffer, __size);       \
     __list;                                          \
 })
 
@@ -69,6 +151,30 @@ typedef struct Forward_List Forward_List;
  */
 #define FWL_cast(_Tp, __iter)          (*(_Tp*)__iter->storage)
 
+/**
+ * @brief  Initializes an intrusive %forward_list.
+ * @param  _Tp       Type of the structures to be linked.
+ * @param  __member  Name of the Forward_List_Link member of @a _Tp.
+ *
+ * An intrusive %forward_list links the caller's own structures through
+ * an embedded Forward_List_Link instead of copying values into nodes it
+ * allocates. Insertion is done with FWL_link_after(), and erasing only
+ * unlinks the structure, its memory is left to the caller. A structure
+ * can be in several lists at once through several link members.
+ *
+ * Splicing, sorting, reversing, FWL_remove_if() and FWL_unique() work
+ * unchanged, and their callbacks receive a pointer to the structure.
+ */
+#define FWL_Init_intrusive(_Tp, __member)  _FWL_Init_intrusive(sizeof(_Tp), offsetof(_Tp, __member))
+
+/**
+ * @brief  The structure holding the link referenced by an iterator.
+ * @param  _Tp       Type of the linked structures.
+ * @param  __member  Name of the Forward_List_Link member of @a _Tp.
+ * @param  __iter    An Iterator into an intrusive %forward_list.
+ */
+#define FWL_entry(_Tp, __member, __iter)   ((_Tp*) ((char*) (__iter) - offsetof(_Tp, __member)))
+
 /**
  * @brief  Assigns an initializer_list to a %forward_list.
  * @param _Tp      The data type used to initialize 
@@ -82,16 +188,7 @@ typedef struct Forward_List Forward_List;
 #define FWL_assign(_Tp, __list, ...)({                              \
    _Tp __buffer[] = __VA_ARGS__;                                    \
     size_t __size = sizeof(__buffer)/sizeof(_Tp);                   \
-    if(!__size){                                                    \
-        FWL_clear(__list);                                          \
-    }else {                                                         \
-        FWL_resize(__list, __size);                                 \
-        _Tp* __buff = __buffer;                                     \
-        for (FWL_iterator __it = FWL_begin(__list); __it != NULL;   \
-                          __it = __it->next, ++__buff){             \
-            FWL_cast(_Tp, __it) = *__buff;                          \
-        }                                                           \
-    }                                                               \
+    FWL_from_array(__list, __buffer, __size);                       \
 })
 
 /**
@@ -219,14 +316,69 @@ extern void FWL_pop_front(Forward_List* __list);
  *
  * This is a typical stack operation.  It shrinks the %forward_list
  * by one. Note that this kind of operation could be expensive for 
- * a %forward_list and if it is frequently used the user should 
- * consider using a doubly linked list.
+ * a %forward_list, finding the new last element is a linear walk,
+ * unless a positional index was enabled with FWL_enable_index().
  *
  * Also note that no data is returned, and if the last element's data
  * is needed, it should be retrieved before FWL_pop_back() is called.
  */
 extern void FWL_pop_back(Forward_List* __list);
 
+/**
+ * @brief  Keeps a positional index of the %forward_list.
+ * @param  __list    Points to %forward_list object.
+ * @param  __stride  Distance between indexed nodes, zero turns the
+ *                   index off and releases it.
+ *
+ * The list then keeps an array holding every @a __stride -th node,
+ * so FWL_at(), FWL_advance_in() and FWL_pop_back() walk at most
+ * @a __stride - 1 nodes, for one pointer of memory per @a __stride
+ * elements (see FWL_index_memory()). FWL_push_back() and FWL_pop_back()
+ * keep the array up to date. Any other operation that reshapes the
+ * list only marks it stale, and it is rebuilt in one walk when next
+ * needed. FWL_clear() releases the array but keeps the setting.
+ */
+extern void FWL_enable_index(Forward_List* __list, size_t __stride);
+
+/**
+ * @brief  Makes FWL_pop_back() run in constant time.
+ * @param  __list    Points to %forward_list object.
+ * @param  __enable  Zero turns the index off and releases it.
+ *
+ * Same as FWL_enable_index() with a stride of one, or zero.
+ */
+extern void FWL_enable_pop_back_index(Forward_List* __list, int __enable);
+
+/**
+ * @brief  Memory held by the positional index, in bytes.
+ * @param  __list   Points to %forward_list object.
+ */
+extern size_t FWL_index_memory(Forward_List* __list);
+
+/**
+ * @brief  Random access to an element.
+ * @param  __list   Points to %forward_list object.
+ * @param  __i      Position of the element.
+ * @return An iterator to the element at position @a __i, or NULL if
+ *         there is no such element.
+ *
+ * Linear in @a __i, or in the stride of the index if one is enabled.
+ */
+extern FWL_iterator FWL_at(Forward_List* __list, size_t __i);
+
+/**
+ * @brief  Moves the iterator a steps forward, using the list index.
+ * @param  __list    Points to %forward_list object.
+ * @param  __current Iterator into the %forward_list.
+ * @param  __n       Number of the steps to move.
+ * @return An iterator that points after @a n elements
+ *         from the @a current iterator.
+ *
+ * Same as FWL_advance(), except that steps from FWL_before_begin()
+ * or FWL_begin() go through FWL_at().
+ */
+extern FWL_iterator FWL_advance_in(Forward_List* __list, FWL_iterator __current, size_t __n);
+
 /**
  * @brief  Removes the element pointed to by the iterator following position.
  * @param  __list       Points to %forward_list object.
@@ -246,6 +398,18 @@ extern FWL_iterator FWL_pop_after(Forward_List* __list, FWL_iterator __position)
 /* Generic _FWL_insert_after() */
 extern FWL_iterator _FWL_insert_after(Forward_List* __list, FWL_iterator __position, void** __storage);
 
+/**
+ * @brief  Links a caller owned structure into an intrusive %forward_list.
+ * @param  __list      Points to an intrusive %forward_list object.
+ * @param  __position  An iterator into the %forward_list.
+ * @param  __link      The link member of the structure to insert.
+ * @return An iterator that points to the inserted structure.
+ *
+ * Nothing is allocated or copied. The link must not already be part
+ * of a list.
+ */
+extern FWL_iterator FWL_link_after(Forward_List* __list, FWL_iterator __position, Forward_List_Link* __link);
+
 /**
  * @brief Inserts given value into %forward_list after specified iterator.
  * @param _Tp           The data type used to initialize 
@@ -285,15 +449,50 @@ extern FWL_iterator _FWL_insert_after(Forward_List* __list, FWL_iterator __posit
  *  and does not invalidate iterators and references.
  */
 #define FWL_insert_after_ilist(_Tp, __list, __position, ...)({        \
-    FWL_iterator __pos = __position;                                  \
    _Tp __buffer[] = __VA_ARGS__;                                      \
     size_t __size = sizeof(__buffer)/sizeof(_Tp);                     \
-    for (size_t __i = 0; __i < __size; ++__i){                        \
-        __pos = FWL_insert_after(_Tp, __list, __pos, __buffer[__i]);  \
-    }                                                                 \
-    __pos;                                                            \
+    FWL_insert_after_array(__list, __position, __buffer, __size);     \
 })
 
+/**
+ *  @brief  Inserts copies of the elements of an array into %forward_list
+ *          after the specified iterator.
+ *  @param  __list       Points to %forward_list object.
+ *  @param  __position   An iterator into the %forward_list.
+ *  @param  __data       Array of @a __n elements of the %forward_list type.
+ *  @param  __n          Number of elements in @a __data.
+ *  @return  An iterator pointing to the last inserted element
+ *           or @a __position if @a __n is 0.
+ *
+ *  The new nodes are allocated and linked in a single pass and spliced
+ *  in at once. An arena backed %forward_list carves them from one
+ *  contiguous block.
+ *
+ *  On an empty %forward_list a null @a __position, as returned by
+ *  FWL_rbegin(), inserts at the front.
+ */
+extern FWL_iterator FWL_insert_after_array(Forward_List* __list, FWL_iterator __position, const void* __data, size_t __n);
+
+/**
+ *  @brief  Replaces the contents of %forward_list with copies of the
+ *          elements of an array.
+ *  @param  __list   Points to %forward_list object.
+ *  @param  __data   Array of @a __n elements of the %forward_list type.
+ *  @param  __n      Number of elements in @a __data.
+ *
+ *  Existing nodes are overwritten in place, surplus nodes are erased
+ *  and missing ones are appended in bulk as by FWL_insert_after_array().
+ */
+extern void FWL_from_array(Forward_List* __list, const void* __data, size_t __n);
+
+/**
+ *  @brief  Copies the elements of %forward_list into an array.
+ *  @param  __list  Points to %forward_list object.
+ *  @param  __out   Buffer of at least FWL_size() elements.
+ *  @return The number of elements copied.
+ */
+extern size_t FWL_to_array(Forward_List* __list, void* __out);
+
 /**
  *  @brief  Insert contents of another %forward_list.
  *  @param  __list      Points to %forward_list object.
@@ -334,6 +533,46 @@ extern void FWL_splice_after_element(Forward_List* __list, FWL_iterator __positi
 extern void FWL_splice_after_range(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __before, 
                                                                                                             FWL_iterator __last);
 
+/**
+ *  @brief  Insert a range of known length from another %forward_list.
+ *  @param  __list       Points to %forward_list object.
+ *  @param  __position   Iterator referencing the element to insert after.
+ *  @param  __src_list   Source list.
+ *  @param  __before     Iterator referencing before the start of range
+ *                       in source list.
+ *  @param  __last_node  Iterator referencing the last element of the range.
+ *  @param  __n          Number of elements in the range (__before,__last_node].
+ *
+ *  Unlike FWL_splice_after_range() the range is not walked to find its
+ *  end and length, so the elements are moved in constant time. The
+ *  caller is responsible for @a __last_node and @a __n being exact.
+ */
+extern void FWL_splice_after_range_n(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __before,
+                                                                             FWL_iterator __last_node, size_t __n);
+
+/**
+ *  @brief  Moves the elements following an iterator to another %forward_list.
+ *  @param  __list      Points to %forward_list object.
+ *  @param  __position  Iterator referencing the last element to keep, or
+ *                      FWL_before_begin() to move everything.
+ *  @param  __index     Number of elements up to and including @a __position.
+ *  @param  __out       Receives the elements, appended after its last one.
+ *
+ *  Runs in constant time.
+ */
+extern void FWL_split_after(Forward_List* __list, FWL_iterator __position, size_t __index, Forward_List* __out);
+
+/**
+ *  @brief  Moves the first elements to another %forward_list.
+ *  @param  __list       Points to %forward_list object.
+ *  @param  __last_node  Iterator referencing the last element to move.
+ *  @param  __n          Number of elements up to and including @a __last_node.
+ *  @param  __out        Receives the elements, appended after its last one.
+ *
+ *  Runs in constant time.
+ */
+extern void FWL_split_prefix(Forward_List* __list, FWL_iterator __last_node, size_t __n, Forward_List* __out);
+
 /**
  * @brief  Removes a range of elements.
  * @param  __list   Points to %forward_list object.
@@ -343,13 +582,26 @@ extern void FWL_splice_after_range(Forward_List* __list, FWL_iterator __position
  *         prior to erasing (or end()).
  *
  * This function will erase the elements in the range @a [first,last) and 
- * shorten the %forward_list accordingly.
+ * shorten the %forward_list accordingly. The range is unlinked with a
+ * single pointer update and its nodes are released in one pass.
  * 
  * Note if the elements themselves are pointers, the pointed-to memory is not
  * touched in any way. Managing the pointer is the user's responsibility.
  */
 extern FWL_iterator FWL_erase_after(Forward_List* __list, FWL_iterator __before, FWL_iterator __last);
 
+/**
+ * @brief  Removes the first elements.
+ * @param  __list  Points to %forward_list object.
+ * @param  __n     Number of elements to remove.
+ * @return The number of elements removed, at most FWL_size().
+ *
+ * Equivalent to calling FWL_pop_front() @a __n times, but the start of
+ * the %forward_list is updated once and the nodes are released in one
+ * pass.
+ */
+extern size_t FWL_pop_front_n(Forward_List* __list, size_t __n);
+
 /**
  * @brief  Returns true if the %forward_list is empty.
  * @param  __list   Points to %forward_list object.
@@ -370,28 +622,328 @@ extern size_t FWL_size(Forward_List* __list);
  * @return Deep copy of a %forward_list object.
  */
 #define FWL_copy(_Tp, __list)({                          \
-    Forward_List __cp = FWL_init(_Tp, {});               \
-    for(FWL_iterator __it = FWL_begin(__list),           \
-                     __iend = FWL_end(__list);           \
-         __it != __iend; __it = __it->next){             \
-        FWL_push_back(_Tp, &__cp, FWL_cast(_Tp, __it));  \
-    }                                                    \
-    __cp;                                                \
+    (void) sizeof(_Tp);                                  \
+    _FWL_copy(__list);                                   \
 })
 
+/* Generic _FWL_copy(), the copy uses the same kind of allocator. */
+extern Forward_List _FWL_copy(Forward_List* __list);
+
 /** 
  * @brief  Sort the elements according to comparison function.
  * @param  __list     Points to %forward_list object.
  * @param  __compare  Comparison function.
  *  
- * This function Sorts the elements according to comparison function.
- * Equivalent elements remain in list order.
+ * This function Sorts the elements according to comparison function,
+ * which returns true when its first argument must be placed after the
+ * second one. Equivalent elements remain in list order.
  * 
- * I don't own the sort algorithm, You can check it via the link below
- * https://www.geeksforgeeks.org/iterative-merge-sort-for-linked-list/
+ * Short lists are sorted with an adaptive natural merge sort. Ascending
+ * and strictly descending runs already present in the input are detected
+ * and merged, so sorted, reversed or nearly sorted lists are sorted in
+ * close to linear time.
+ *
+ * Long lists are gathered into an array of node pointers that is sorted
+ * with a stable merge sort and relinked, which avoids chasing pointers
+ * through memory on every merge pass.
  */
 extern void FWL_sort(Forward_List* __list, int (*__compare)(const void *, const void *));
 
+/** 
+ * @brief  Sort the elements according to a three-way comparison function.
+ * @param  __list     Points to %forward_list object.
+ * @param  __compare  Comparison function in the style of qsort(), returns
+ *                    a negative, zero or positive value.
+ *  
+ * Same algorithm as FWL_sort(). Equivalent elements remain in list order.
+ */
+extern void FWL_sort3(Forward_List* __list, int (*__compare)(const void *, const void *));
+
+/** 
+ * @brief  Sort the elements using cached key prefixes.
+ * @param  __list     Points to %forward_list object.
+ * @param  __compare  Comparison function, same convention as FWL_sort().
+ * @param  __prefix   Maps an element to an 8 byte prefix of its key.
+ *  
+ * The node pointers are gathered in an array together with the prefix
+ * of every element, the array is sorted and the list is relinked.
+ * Elements with different prefixes are ordered by the prefixes alone
+ * and @a __compare is only called for equal prefixes, so the prefix must
+ * preserve the order: prefix(a) < prefix(b) whenever @a a sorts before
+ * @a b. Equivalent elements remain in list order.
+ */
+extern void FWL_sort_prefixed(Forward_List* __list, int (*__compare)(const void *, const void *), uint64_t (*__prefix)(const void *));
+
+/**
+ * @brief  Key prefix of a %forward_list of char*, for FWL_sort_prefixed().
+ * @param  __value  Points to a char* element.
+ * @return The first 8 bytes of the string, most significant first.
+ *
+ * Matches the order of strcmp().
+ */
+extern uint64_t FWL_string_prefix(const void* __value);
+
+/** 
+ * @brief  Sort the elements on several threads.
+ * @param  __list      Points to %forward_list object.
+ * @param  __compare   Comparison function, same convention as FWL_sort().
+ * @param  __nthreads  Number of threads to use, the caller included.
+ *  
+ * The %forward_list is cut into @a __nthreads sublists of balanced
+ * lengths in one pass. The sublists are sorted concurrently and then
+ * merged pairwise, the merges of each level of the tree running
+ * concurrently as well. Nodes are relinked and never copied.
+ *
+ * The result is identical to FWL_sort(). Short lists and calls with
+ * fewer than two threads fall back to FWL_sort(), and so do calls made
+ * from a function run by FWL_parallel_for_each() or another parallel
+ * walk. The comparison function is called from several threads at once.
+ *
+ * The threads come from a process-wide pool of persistent workers,
+ * started lazily by the first calls that need them and never stopped,
+ * 64 threads at most, the caller included. Concurrent calls from
+ * different threads are serialized on the pool.
+ */
+extern void FWL_sort_parallel(Forward_List* __list, int (*__compare)(const void *, const void *), size_t __nthreads);
+
+/**
+ * @brief  Merge sorted lists.
+ * @param  __list      Points to a sorted %forward_list object.
+ * @param  __src_list  Points to a sorted %forward_list object.
+ * @param  __compare   Comparison function, same convention as FWL_sort().
+ *
+ * The nodes of @a __src_list are relinked into @a __list in a single
+ * linear pass, leaving @a __src_list empty. Equivalent elements keep
+ * their order, those of @a __list preceding those of @a __src_list.
+ */
+extern void FWL_merge(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *));
+
+/**
+ * @brief  Union of sorted lists.
+ * @param  __list      Points to a sorted %forward_list object, receives the result.
+ * @param  __src_list  Points to a sorted %forward_list object, left empty.
+ * @param  __compare   Comparison function, same convention as FWL_sort().
+ *
+ * Keeps every element of @a __list and the elements of @a __src_list
+ * without an equivalent in @a __list, matching elements one to one as
+ * std::set_union does. The work is linear, nodes are relinked and the
+ * unused ones are released.
+ */
+extern void FWL_set_union(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *));
+
+/**
+ * @brief  Intersection of sorted lists.
+ * @param  __list      Points to a sorted %forward_list object, receives the result.
+ * @param  __src_list  Points to a sorted %forward_list object, left empty.
+ * @param  __compare   Comparison function, same convention as FWL_sort().
+ *
+ * Keeps the elements of @a __list that have an equivalent in
+ * @a __src_list, matching elements one to one. The work is linear and
+ * the unused nodes of both lists are released.
+ */
+extern void FWL_set_intersection(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *));
+
+/**
+ * @brief  Difference of sorted lists.
+ * @param  __list      Points to a sorted %forward_list object, receives the result.
+ * @param  __src_list  Points to a sorted %forward_list object, left empty.
+ * @param  __compare   Comparison function, same convention as FWL_sort().
+ *
+ * Keeps the elements of @a __list that have no equivalent in
+ * @a __src_list, matching elements one to one. The work is linear and
+ * the unused nodes of both lists are released.
+ */
+extern void FWL_set_difference(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *));
+
+/* Kinds of keys understood by FWL_sort_radix(). */
+typedef enum Forward_List_Key_Kind
+{
+    FWL_KEY_UNSIGNED,   /* Unsigned integer of 1, 2, 4 or 8 bytes. */
+    FWL_KEY_SIGNED,     /* Two's complement integer of 1, 2, 4 or 8 bytes. */
+    FWL_KEY_FLOAT       /* IEEE 754 float (4 bytes) or double (8 bytes). */
+} Forward_List_Key_Kind;
+
+/** 
+ * @brief  Sort the elements by a fixed width numeric key.
+ * @param  __list        Points to %forward_list object.
+ * @param  __key_offset  Offset of the key within an element.
+ * @param  __key_width   Size of the key in bytes.
+ * @param  __kind        How the key bytes are to be interpreted.
+ *  
+ * This is a least significant digit radix sort on the bytes of the key.
+ * Each pass distributes the nodes into 256 buckets by relinking them,
+ * elements are never copied and no comparison function is called.
+ * Passes on bytes that are equal for every key are skipped. Equivalent
+ * elements remain in list order. Negative zero sorts before positive
+ * zero, and NaNs sort after infinities according to their sign.
+ */
+extern void FWL_sort_radix(Forward_List* __list, size_t __key_offset, size_t __key_width, Forward_List_Key_Kind __kind);
+
+/**
+ * @brief  Keeps the %forward_list sorted.
+ * @param  __list     Points to %forward_list object, sorted by @a __compare.
+ * @param  __compare  Comparison function, same convention as FWL_sort().
+ *
+ * Enables FWL_insert_sorted(), FWL_find_sorted() and FWL_lower_bound(),
+ * which search in expected logarithmic time through a skip list built
+ * above the nodes. The nodes stay an ordinary %forward_list, so
+ * iteration and every other function keep working. Operations that
+ * remove or move nodes only mark the skip list stale, and it is rebuilt
+ * in one walk by the next search. FWL_clear() releases it but keeps
+ * the comparison function.
+ */
+extern void FWL_enable_sorted(Forward_List* __list, int (*__compare)(const void *, const void *));
+
+/* Generic _FWL_insert_sorted() */
+extern FWL_iterator _FWL_insert_sorted(Forward_List* __list, const void* __value);
+
+/**
+ * @brief  Inserts a value at its place in a sorted %forward_list.
+ * @param  _Tp     The data type used to initialize
+ *                 the %forward_list.
+ * @param  __list  Points to a %forward_list object, see FWL_enable_sorted().
+ * @param  ...     Data to be inserted.
+ * @return An iterator that points to the inserted data.
+ *
+ * The value goes after the elements equal to it.
+ */
+#define FWL_insert_sorted(_Tp, __list, ...)({      \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWL_insert_sorted(__list, &__value);          \
+})
+
+/* Generic _FWL_lower_bound() */
+extern FWL_iterator _FWL_lower_bound(Forward_List* __list, const void* __value);
+
+/**
+ * @brief  Finds the first element not less than a value.
+ * @param  _Tp     The data type used to initialize
+ *                 the %forward_list.
+ * @param  __list  Points to a %forward_list object, see FWL_enable_sorted().
+ * @param  ...     Value to search for.
+ * @return An iterator to the element, or NULL if every element is less.
+ */
+#define FWL_lower_bound(_Tp, __list, ...)({        \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWL_lower_bound(__list, &__value);            \
+})
+
+/* Generic _FWL_find_sorted() */
+extern FWL_iterator _FWL_find_sorted(Forward_List* __list, const void* __value);
+
+/**
+ * @brief  Finds an element equal to a value.
+ * @param  _Tp     The data type used to initialize
+ *                 the %forward_list.
+ * @param  __list  Points to a %forward_list object, see FWL_enable_sorted().
+ * @param  ...     Value to search for.
+ * @return An iterator to the first equal element, or NULL if there is none.
+ */
+#define FWL_find_sorted(_Tp, __list, ...)({        \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWL_find_sorted(__list, &__value);            \
+})
+
+/**
+ * @brief  Calls a function on every element, in list order.
+ * @param  __list  Points to %forward_list object.
+ * @param  __fn    Function receiving each element and @a __ctx.
+ * @param  __ctx   User data passed through to @a __fn.
+ *
+ * If a positional index is enabled and up to date (see
+ * FWL_enable_index()), its entries serve as jump pointers to request
+ * nodes several strides ahead, so the cache misses of a scattered list
+ * overlap. The smaller the stride, the larger the gain, see
+ * bench/bench_for_each.c. @a __fn must not add or remove elements.
+ */
+extern void FWL_for_each(Forward_List* __list, void (*__fn)(void *, void *), void* __ctx);
+
+/**
+ * @brief  Calls a function on a range of elements, in list order.
+ * @param  __list    Points to %forward_list object.
+ * @param  __before  An iterator pointing before the first element to visit.
+ * @param  __last    An iterator pointing to one past the last element to visit.
+ * @param  __fn      Function receiving each element and @a __ctx.
+ * @param  __ctx     User data passed through to @a __fn.
+ *
+ * Same as FWL_for_each() over the range (__before,__last).
+ */
+extern void FWL_for_each_range(Forward_List* __list, FWL_iterator __before, FWL_iterator __last,
+                               void (*__fn)(void *, void *), void* __ctx);
+
+/**
+ * @brief  Calls a function on every element from several threads.
+ * @param  __list      Points to %forward_list object.
+ * @param  __fn        Function receiving each element and @a __ctx.
+ * @param  __ctx       User data passed through to @a __fn.
+ * @param  __nthreads  Number of threads to use, the caller included.
+ *
+ * The %forward_list is cut into balanced chunks in one pass, a few per
+ * thread, and the chunks are walked by a work stealing pool, so threads
+ * that finish early help those given slower elements. Within a chunk
+ * the elements are visited in list order, but chunks run concurrently,
+ * so @a __fn and whatever it shares through @a __ctx must be thread
+ * safe. Short lists and calls with fewer than two threads fall back to
+ * FWL_for_each(). @a __fn must not add or remove elements.
+ *
+ * Parallel walks and FWL_sort_parallel() called from @a __fn do not
+ * wait for the pool, they run sequentially on the thread calling them.
+ *
+ * The threads come from a process-wide pool of persistent workers,
+ * started lazily by the first calls that need them and never stopped,
+ * 64 threads at most, the caller included. Concurrent calls from
+ * different threads are serialized on the pool.
+ */
+extern void FWL_parallel_for_each(Forward_List* __list, void (*__fn)(void *, void *), void* __ctx, size_t __nthreads);
+
+/**
+ * @brief  Counts the elements satisfying a predicate, using several threads.
+ * @param  __list       Points to %forward_list object.
+ * @param  __predicate  Unary predicate function, called from several threads.
+ * @param  __nthreads   Number of threads to use, the caller included.
+ * @return The number of elements for which the predicate returns true.
+ *
+ * Runs on the worker pool described at FWL_parallel_for_each().
+ */
+extern size_t FWL_parallel_count_if(Forward_List* __list, int (*__predicate)(const void *), size_t __nthreads);
+
+/**
+ * @brief  Folds the elements into a single value, using several threads.
+ * @param  __list         Points to %forward_list object.
+ * @param  __result       Holds the identity value on entry and the
+ *                        result on return.
+ * @param  __result_size  Size of the value @a __result points to.
+ * @param  __accumulate   Adds an element, second argument, to a partial
+ *                        result, first argument.
+ * @param  __combine      Adds a partial result, second argument, to
+ *                        another, first argument.
+ * @param  __nthreads     Number of threads to use, the caller included.
+ *
+ * Each chunk is folded in list order into its own copy of the identity
+ * value, then the partial results are combined into @a __result in
+ * list order too, so @a __combine needs to be associative but not
+ * commutative. Runs on the worker pool described at
+ * FWL_parallel_for_each().
+ */
+extern void FWL_parallel_reduce(Forward_List* __list, void* __result, size_t __result_size,
+                                void (*__accumulate)(void *, const void *), void (*__combine)(void *, const void *),
+                                size_t __nthreads);
+
+/**
+ * @brief  Removes all elements satisfying a predicate, using several threads.
+ * @param  __list       Points to %forward_list object.
+ * @param  __predicate  Unary predicate function, called from several threads.
+ * @param  __nthreads   Number of threads to use, the caller included.
+ * @return The number of elements removed.
+ *
+ * Same result as FWL_remove_if(). The chunks are filtered concurrently
+ * and the kept elements stitched back in list order. The removed nodes
+ * are released afterwards by the calling thread, so pooled lists keep
+ * their nodes in the cache of that thread. Runs on the worker pool
+ * described at FWL_parallel_for_each().
+ */
+extern size_t FWL_parallel_remove_if(Forward_List* __list, int (*__predicate)(const void *), size_t __nthreads);
+
 /* Generic  _FWL_remove() */
 extern void _FWL_remove(Forward_List* __list, const void* __valuePtr, int (*__compare)(const void *, const void *));
 
@@ -430,6 +982,33 @@ extern void _FWL_remove(Forward_List* __list, const void* __valuePtr, int (*__co
  */
 extern void FWL_remove_if(Forward_List* __list, int (*__predicate)(const void *));
 
+/**
+ *  @brief  Moves all elements satisfying a predicate to another list.
+ *  @param  __list       Points to %forward_list object.
+ *  @param  __predicate  Unary predicate function.
+ *  @param  __out_list   Points to the %forward_list receiving the elements.
+ *  @return The number of elements moved.
+ *
+ *  The matching nodes are unlinked in a single pass and appended to
+ *  @a __out_list in list order, so nothing is allocated, copied or
+ *  freed. Both lists must allow splicing between them.
+ */
+extern size_t FWL_extract_if(Forward_List* __list, int (*__predicate)(const void *), Forward_List* __out_list);
+
+/**
+ *  @brief  Partitions the elements according to a predicate.
+ *  @param  __list       Points to %forward_list object.
+ *  @param  __predicate  Unary predicate function.
+ *  @param  __out_list   Points to the %forward_list receiving the matching
+ *                       elements, or NULL.
+ *  @return The number of elements satisfying the predicate.
+ *
+ *  With an @a __out_list this is FWL_extract_if(). Without one, the
+ *  matching elements are moved in front of the others, in one pass and
+ *  by relinking only. Both groups keep their relative order.
+ */
+extern size_t FWL_partition(Forward_List* __list, int (*__predicate)(const void *), Forward_List* __out_list);
+
 /**
  * @brief  Removes consecutive duplicate elements according to comparison function.
  * @param  __list     Points to %forward_list object.
@@ -445,6 +1024,64 @@ extern void FWL_remove_if(Forward_List* __list, int (*__predicate)(const void *)
  */
 extern void FWL_unique(Forward_List* __list, int (*__compare)(const void *, const void *));
 
+/**
+ * @brief  Removes all duplicate elements, wherever they are.
+ * @param  __list     Points to %forward_list object.
+ * @param  __hash     Hash function, equal elements must hash alike.
+ * @param  __equal    Comparison function, returns true for equal elements.
+ *
+ * The first occurrence of every value is kept and the list does not need
+ * to be sorted. Elements are looked up in a temporary hash set as the
+ * list is walked once, so the expected cost is linear.
+ */
+extern void FWL_unique_hashed(Forward_List* __list, size_t (*__hash)(const void *), int (*__equal)(const void *, const void *));
+
+/**
+ * @brief  Removes all elements equal to any of several values.
+ * @param  __list     Points to %forward_list object.
+ * @param  __values   Array of @a __k values of the element type.
+ * @param  __k        Number of values.
+ * @param  __hash     Hash function, equal elements must hash alike.
+ * @param  __equal    Comparison function, returns true for equal elements.
+ *
+ * The values are put in a temporary hash set and the list is walked
+ * once, instead of once per value as with FWL_remove(). Remaining
+ * elements stay in list order.
+ */
+extern void FWL_remove_any(Forward_List* __list, const void* __values, size_t __k, size_t (*__hash)(const void *),
+                           int (*__equal)(const void *, const void *));
+
+/**
+ * @brief  Moves the elements into fresh nodes laid out in list order.
+ * @param  __list   Points to %forward_list object.
+ *
+ * Sorting, reversing and splicing leave neighbouring elements in
+ * scattered nodes, which makes later traversals miss the cache. This
+ * copies every element into newly allocated nodes and releases the old
+ * ones. An arena list moves into a new arena, whose nodes are contiguous
+ * in list order, and drops the previous slabs whole. Heap and pooled
+ * lists get their new nodes linked by increasing address, so a walk
+ * only moves forward in memory, but how close together the nodes lie
+ * is up to malloc() and the pool.
+ *
+ * All iterators into the %forward_list are invalidated.
+ */
+extern void FWL_compact(Forward_List* __list);
+
+/**
+ * @brief  Compacts a bounded part of the %forward_list.
+ * @param  __list    Points to %forward_list object.
+ * @param  __before  An iterator pointing before the first element to move.
+ * @param  __n       Maximum number of elements to move.
+ * @return An iterator to the last element moved, to pass to the next
+ *         call, or NULL once the end of the list is reached.
+ *
+ * Same as FWL_compact() for the elements following @a __before only,
+ * so that the work can be spread over several calls. Iterators to the
+ * moved elements are invalidated.
+ */
+extern FWL_iterator FWL_compact_some(Forward_List* __list, FWL_iterator __before, size_t __n);
+
 /**
  * @brief  Reverse the elements in %forward_list.
  * @param  __list   Points to %forward_list object.
@@ -487,6 +1124,58 @@ extern void FWL_clear(Forward_List* __list);
 /* Initializes the %forward_list. */
 extern Forward_List FWL_Init(size_t);
 
+/* Initializes an intrusive %forward_list, see FWL_Init_intrusive(). */
+extern Forward_List _FWL_Init_intrusive(size_t __size, size_t __link_offset);
+
+/**
+ * @brief  Initializes an arena backed %forward_list.
+ * @param  __size        Size of the data to be stored in the %forward_list.
+ * @param  __slab_nodes  Number of nodes carved from each slab, or 0 to
+ *                       let the %forward_list pick a slab of about 64KiB.
+ *
+ * Nodes of the returned %forward_list are allocated from large slabs
+ * instead of one calloc() per element, and erased nodes are recycled
+ * through an internal free list. FWL_clear() releases the whole arena
+ * in time linear in the number of slabs rather than the number of nodes.
+ *
+ * Nodes never leave their arena, so elements can only be spliced between
+ * an arena backed %forward_list and itself.
+ */
+extern Forward_List FWL_Init_arena(size_t __size, size_t __slab_nodes);
+
+/**
+ * @brief  Initializes a pool backed %forward_list.
+ * @param  __size  Size of the data to be stored in the %forward_list.
+ *
+ * Nodes of the returned %forward_list come from a process-wide pool
+ * keyed by @a __size. Each thread keeps a small cache of free nodes per
+ * size class, so allocating and erasing a node is usually a pointer pop
+ * or push without any locking. Full caches are exchanged with a shared
+ * depot in batches.
+ *
+ * Pooled lists of the same element size can splice nodes between each
+ * other freely.
+ */
+extern Forward_List FWL_Init_pooled(size_t __size);
+
+/**
+ * @brief  Reads the counters of the node pool.
+ * @param  __stats  Receives the counters.
+ *
+ * Counters of other threads are folded in whenever those threads
+ * exchange nodes with the shared depot or exit, so the figures are
+ * exact for the calling thread and approximate for the others.
+ */
+extern void FWL_pool_stats(Forward_List_Pool_Stats* __stats);
+
+/**
+ * @brief  Returns the free nodes of the pool to the system.
+ *
+ * Releases the cache of the calling thread and the shared depot.
+ * Caches of other threads are left alone.
+ */
+extern void FWL_pool_trim(void);
+
 #endif
 
 
@@ -0,0 +1,273 @@
+/**
+ *  @brief A compact generic %forward_list whose nodes live in one
+ *  growable arena and are linked by 32-bit indices.
+ *
+ *  Every node of a Forward_List32 is a 4 byte link followed by the
+ *  element, stored back to back in a single block owned by the list.
+ *  Compared with Forward_List this saves the 8 byte pointer and the
+ *  per-node allocator header, which roughly halves the memory used by
+ *  lists of small elements and packs twice as many nodes per cache line.
+ *
+ *  Iterators are node indices rather than pointers, so they stay valid
+ *  when the arena grows. A list can hold up to 2^32 - 2 elements.
+ *
+ *  @file forward_list32.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST32
+#define FORWARD_LIST32
+
+#include <stddef.h>
+#include <stdint.h>
+#include "forward_list.h"
+
+typedef uint32_t FWL32_iterator;
+
+/* Index of no node, returned by FWL32_end(). */
+#define FWL32_NIL ((FWL32_iterator) UINT32_MAX)
+
+/* Index of the before-begin sentinel, whose link is the first element. */
+#define FWL32_BEFORE_BEGIN ((FWL32_iterator) 0)
+
+struct Forward_List32
+{
+    Forward_List_Generic* nodes;  /* Node 0 is the before-begin sentinel. */
+    uint32_t capacity;            /* Nodes the arena can hold. */
+    uint32_t used;                /* Nodes ever handed out. */
+    uint32_t free_nodes;          /* Chain of erased nodes ready for reuse. */
+    uint32_t finish;              /* Last element, or FWL32_NIL. */
+    size_t count;
+    size_t size;
+    size_t stride;                /* Distance between two nodes. */
+    size_t offset;                /* Offset of the element within a node. */
+};
+
+typedef struct Forward_List32 Forward_List32;
+
+/**
+ * @brief  The link of a node, read/write.
+ * @param  __list  Points to %forward_list32 object.
+ * @param  __iter  An iterator into the %forward_list32.
+ */
+#define FWL32_link(__list, __iter)                                                 \
+    (*(uint32_t*) ((__list)->nodes + (size_t)(__iter) * (__list)->stride))
+
+/**
+ * @brief  Generic pointer to the element of a node.
+ * @param  __list  Points to %forward_list32 object.
+ * @param  __iter  An iterator into the %forward_list32.
+ */
+#define FWL32_storage(__list, __iter)                                              \
+    ((void*) ((__list)->nodes + (size_t)(__iter) * (__list)->stride + (__list)->offset))
+
+/**
+ * @brief  Cast generic type into true data type.
+ * @param  _Tp     The data type used to initialize
+ *                 the %forward_list32.
+ * @param  __list  Points to %forward_list32 object.
+ * @param  __iter  An Iterator into %forward_list32.
+ */
+#define FWL32_cast(_Tp, __list, __iter)  (*(_Tp*) FWL32_storage(__list, __iter))
+
+/**
+ * @param  __list  Points to %forward_list32 object.
+ * @param  __iter  An Iterator into %forward_list32.
+ * @return An iterator to the element following @a __iter.
+ */
+#define FWL32_next(__list, __iter)       FWL32_link(__list, __iter)
+
+/**
+ * @brief  Initializes the %forward_list32.
+ * @param  _Tp  Type of the data to be stored in the %forward_list32.
+ * @param  ...  The provided initializer list.
+ */
+#define FWL32_init(_Tp, ...) ({                          \
+   _Tp __buffer[] = __VA_ARGS__;                         \
+    size_t __size = sizeof(__buffer)/sizeof(_Tp);        \
+    Forward_List32 __list = FWL32_Init(sizeof(_Tp));     \
+    for (size_t __i = 0; __i < __size; ++__i){           \
+        FWL32_push_back(_Tp, &__list, __buffer[__i]);    \
+    }                                                    \
+    __list;                                              \
+})
+
+/* Initializes the %forward_list32. */
+extern Forward_List32 FWL32_Init(size_t __size);
+
+/**
+ * @param __list Points to %forward_list32 object.
+ *
+ * Returns an iterator that points before the first element
+ * in the %forward_list32.
+ */
+extern FWL32_iterator FWL32_before_begin(Forward_List32* __list);
+
+/**
+ * @param __list Points to %forward_list32 object.
+ *
+ * Returns an iterator that points to the first element
+ * in the %forward_list32.
+ */
+extern FWL32_iterator FWL32_begin(Forward_List32* __list);
+
+/**
+ * @param __list Points to %forward_list32 object.
+ *
+ * Returns an iterator that points to the last element
+ * in the %forward_list32.
+ */
+extern FWL32_iterator FWL32_rbegin(Forward_List32* __list);
+
+/**
+ * @param __list Points to %forward_list32 object.
+ *
+ * Returns an iterator that points one past the last element
+ * in the %forward_list32.
+ */
+extern FWL32_iterator FWL32_end(Forward_List32* __list);
+
+/* Generic _FWL32_insert_after() */
+extern FWL32_iterator _FWL32_insert_after(Forward_List32* __list, FWL32_iterator __position, void** __storage);
+
+/**
+ * @brief Inserts given value into %forward_list32 after specified iterator.
+ * @param _Tp           The data type used to initialize
+ *                      the %forward_list32.
+ * @param  __list       Points to a %forward_list32 object.
+ * @param  __position   An iterator into the %forward_list32.
+ * @param ...           Data to be inserted.
+ * @return An iterator that points to the inserted data.
+ *
+ * The arena may move while growing, so the element is stored only
+ * once the node exists.
+ */
+#define FWL32_insert_after(_Tp, __list, __position, ...)({                               \
+   _Tp* __storage = NULL;                                                                \
+    FWL32_iterator __ret = _FWL32_insert_after(__list, __position, (void**)& __storage); \
+    *__storage = (_Tp)__VA_ARGS__;                                                       \
+    __ret;                                                                               \
+})
+
+/**
+ * @brief  Add data to the end of the %forward_list32.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list32.
+ * @param  __list  Points to %forward_list32 object.
+ * @param  ...     Data to be added.
+ */
+#define FWL32_push_back(_Tp, __list, ...) ({                              \
+    FWL32_insert_after(_Tp, __list, FWL32_rbegin(__list), __VA_ARGS__);   \
+})
+
+/**
+ * @brief  Add data to the front of the %forward_list32.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list32.
+ * @param  __list  Points to %forward_list32 object.
+ * @param  ...     Data to be added.
+ */
+#define FWL32_push_front(_Tp, __list, ...) ({                                  \
+    FWL32_insert_after(_Tp, __list, FWL32_before_begin(__list), __VA_ARGS__);  \
+})
+
+/**
+ * @brief  Removes first element.
+ * @param __list Points to %forward_list32 object.
+ */
+extern void FWL32_pop_front(Forward_List32* __list);
+
+/**
+ * @brief  Removes the element following position.
+ * @param  __list       Points to %forward_list32 object.
+ * @param  __position   An iterator pointing before the element to be erased.
+ * @return An iterator pointing to the element following the one that was
+ *         erased, or FWL32_end() if no such element exists.
+ */
+extern FWL32_iterator FWL32_pop_after(Forward_List32* __list, FWL32_iterator __position);
+
+/**
+ * @brief  Removes a range of elements.
+ * @param  __list   Points to %forward_list32 object.
+ * @param  __before An iterator pointing before the first element to be erased.
+ * @param  __last   An iterator pointing to one past the last element to be erased.
+ * @return @a __last.
+ */
+extern FWL32_iterator FWL32_erase_after(Forward_List32* __list, FWL32_iterator __before, FWL32_iterator __last);
+
+/**
+ *  @brief  Insert contents of another %forward_list32.
+ *  @param  __list      Points to %forward_list32 object.
+ *  @param  __position  Iterator referencing the element to insert after.
+ *  @param  __src_list  Source list.
+ *
+ *  The elements of @a src_list are moved into @a list after @a position
+ *  and @a src_list becomes an empty list. Since every %forward_list32
+ *  owns its arena the elements are copied, which is linear in the size
+ *  of @a src_list.
+ */
+extern void FWL32_splice_after_list(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list);
+
+/**
+ *  @brief  Insert element from another %forward_list32.
+ *  @param  __list      Points to %forward_list32 object.
+ *  @param  __position  Iterator referencing the element to insert after.
+ *  @param  __src_list  Source list.
+ *  @param  __i         Iterator referencing the element before the element
+ *                      to move.
+ *
+ *  Moving an element within the same %forward_list32 is done in constant
+ *  time by relinking.
+ */
+extern void FWL32_splice_after_element(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list,
+                                                                                          FWL32_iterator __i);
+
+/**
+ *  @brief  Insert range from another %forward_list32.
+ *  @param  __list      Points to %forward_list32 object.
+ *  @param  __position  Iterator referencing the element to insert after.
+ *  @param  __src_list  Source list.
+ *  @param  __before    Iterator referencing before the start of range
+ *                      in source list.
+ *  @param  __last      Iterator referencing the end of range in source list.
+ *
+ *  Removes elements in the range (__before,__last) in @a src_list and
+ *  inserts them in @a list after @a __position.
+ */
+extern void FWL32_splice_after_range(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list,
+                                                            FWL32_iterator __before, FWL32_iterator __last);
+
+/**
+ * @brief  Returns true if the %forward_list32 is empty.
+ * @param  __list   Points to %forward_list32 object.
+ */
+extern int FWL32_empty(Forward_List32* __list);
+
+/**
+ * @brief  Returns the number of elements in the %forward_list32.
+ * @param  __list   Points to %forward_list32 object.
+ */
+extern size_t FWL32_size(Forward_List32* __list);
+
+/**
+ * @brief  Sort the elements according to comparison function.
+ * @param  __list     Points to %forward_list32 object.
+ * @param  __compare  Comparison function, same convention as FWL_sort().
+ *
+ * Equivalent elements remain in list order.
+ */
+extern void FWL32_sort(Forward_List32* __list, int (*__compare)(const void *, const void *));
+
+/**
+ * @brief  Reverse the elements in %forward_list32.
+ * @param  __list   Points to %forward_list32 object.
+ */
+extern void FWL32_reverse(Forward_List32* __list);
+
+/**
+ * @brief  Erases all the elements and releases the arena.
+ * @param  __list   Points to %forward_list32 object.
+ */
+extern void FWL32_clear(Forward_List32* __list);
+
+#endif
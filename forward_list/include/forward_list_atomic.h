@@ -0,0 +1,110 @@
+/**
+ *  @brief A generic %forward_list that many threads can push to and pop
+ *  from at once without locks.
+ *
+ *  Forward_List_Atomic is a Treiber stack of ordinary Forward_List_Node
+ *  nodes: FWLA_push_front() and FWLA_pop_front() each publish their
+ *  change with one compare-and-swap on the first node. Popped nodes are
+ *  released through epoch based reclamation (see forward_list_epoch.h),
+ *  so a node cannot be reused while another thread still looks at it
+ *  and pops are safe from the ABA problem.
+ *
+ *  FWLA_take_all() detaches every element at once and returns them as a
+ *  plain heap Forward_List, in last pushed first order, for batch
+ *  consumption by the calling thread.
+ *
+ *  @file forward_list_atomic.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_ATOMIC
+#define FORWARD_LIST_ATOMIC
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "forward_list.h"
+
+struct Forward_List_Atomic
+{
+    _Atomic(Forward_List_Node*) start;
+    atomic_size_t count;            /* Never below the number of linked elements. */
+    size_t size;
+};
+
+typedef struct Forward_List_Atomic Forward_List_Atomic;
+
+/* Initializes the %forward_list_atomic. */
+extern void FWLA_Init(Forward_List_Atomic* __list, size_t __size);
+
+/* Generic _FWLA_push_front() */
+extern void _FWLA_push_front(Forward_List_Atomic* __list, const void* __value);
+
+/**
+ * @brief  Add data to the front of the %forward_list_atomic.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_atomic.
+ * @param  __list  Points to %forward_list_atomic object.
+ * @param  ...     Data to be added.
+ *
+ * Lock-free, may be called by any number of threads at once.
+ */
+#define FWLA_push_front(_Tp, __list, ...)({        \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLA_push_front(__list, &__value);            \
+})
+
+/**
+ * @brief  Add every element of a %forward_list to the front.
+ * @param  __list      Points to %forward_list_atomic object.
+ * @param  __src_list  A heap %forward_list of the same element size,
+ *                     left empty.
+ *
+ * The nodes of @a __src_list are published at once, in their order,
+ * with a single compare-and-swap.
+ */
+extern void FWLA_push_list(Forward_List_Atomic* __list, Forward_List* __src_list);
+
+/**
+ * @brief  Removes first element.
+ * @param  __list  Points to %forward_list_atomic object.
+ * @param  __out   Receives a copy of the element, may be NULL.
+ * @return True if an element was removed, false if the list was empty.
+ *
+ * Lock-free, may be called by any number of threads at once.
+ */
+extern int FWLA_pop_front(Forward_List_Atomic* __list, void* __out);
+
+/**
+ * @brief  Removes every element at once.
+ * @param  __list  Points to %forward_list_atomic object.
+ * @return A heap %forward_list holding the elements, first pushed last.
+ *
+ * The elements are detached with one atomic exchange. The call then
+ * waits for the pops that may still be reading the detached nodes to
+ * end, so the returned list can be used and released freely. It must
+ * not be called inside an epoch critical section.
+ */
+extern Forward_List FWLA_take_all(Forward_List_Atomic* __list);
+
+/**
+ * @brief  Returns true if the %forward_list_atomic is empty.
+ * @param  __list   Points to %forward_list_atomic object.
+ */
+extern int FWLA_empty(Forward_List_Atomic* __list);
+
+/**
+ * @brief  Returns the number of elements in the %forward_list_atomic.
+ * @param  __list   Points to %forward_list_atomic object.
+ *
+ * While other threads modify the list this is only a snapshot, which
+ * may briefly count elements still being pushed.
+ */
+extern size_t FWLA_size(Forward_List_Atomic* __list);
+
+/**
+ * @brief  Erases all the elements.
+ * @param  __list   Points to %forward_list_atomic object.
+ */
+extern void FWLA_clear(Forward_List_Atomic* __list);
+
+#endif
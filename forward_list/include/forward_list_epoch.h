@@ -0,0 +1,56 @@
+/**
+ *  @brief Epoch based reclamation shared by the concurrent lists.
+ *
+ *  A node unlinked from a lock-free structure cannot be freed at once,
+ *  other threads may still be reading it. Threads wrap every access to
+ *  such a structure in FWL_epoch_enter() and FWL_epoch_exit(), and
+ *  unlinked nodes are handed to FWL_epoch_retire(). A retired node is
+ *  released once every thread that could have seen it has left its
+ *  critical section, which also rules out the ABA problem since an
+ *  address cannot come back while it is still referenced.
+ *
+ *  Critical sections may nest and must be short, a thread sleeping in
+ *  one holds back reclamation for all.
+ *
+ *  @file forward_list_epoch.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_EPOCH
+#define FORWARD_LIST_EPOCH
+
+/* Enters a critical section of the calling thread. */
+extern void FWL_epoch_enter(void);
+
+/* Leaves the critical section entered last. */
+extern void FWL_epoch_exit(void);
+
+/**
+ * @brief  Releases memory once no thread can reference it any more.
+ * @param  __ptr      Memory already unlinked from every shared structure.
+ * @param  __release  Function releasing @a __ptr, free() for instance.
+ *
+ * May be called inside or outside a critical section. Retired memory is
+ * collected in batches, so @a __release runs later, on the calling
+ * thread or on a thread that later reuses its records.
+ */
+extern void FWL_epoch_retire(void* __ptr, void (*__release)(void *));
+
+/**
+ * @brief  Waits for a grace period.
+ *
+ * Returns once every critical section that was running at the time of
+ * the call has ended. Memory unlinked before the call may then be
+ * reused directly. Must not be called inside a critical section.
+ */
+extern void FWL_epoch_synchronize(void);
+
+/**
+ * @brief  Releases everything the calling thread has retired.
+ *
+ * Waits for the grace periods needed first. Must not be called inside
+ * a critical section.
+ */
+extern void FWL_epoch_flush(void);
+
+#endif
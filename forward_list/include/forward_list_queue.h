@@ -0,0 +1,133 @@
+/**
+ *  @brief A bounded first in first out queue passing elements from any
+ *  number of producer threads to one consumer thread.
+ *
+ *  Forward_List_Queue is an intrusive multi-producer single-consumer
+ *  queue of ordinary Forward_List_Node nodes. A producer links its node
+ *  at the end with one atomic exchange and one store, and the consumer
+ *  unlinks from the front without atomic read-modify-write at all, so a
+ *  single producer and its consumer never contend on a lock.
+ *
+ *  FWLQ_push_list() and FWLQ_pop_list() move whole chains of nodes in and
+ *  out of a plain heap Forward_List, like FWL_splice_after_list(): the
+ *  source list is left empty and the elements keep their order.
+ *
+ *  Consumed nodes go back to the producers through a recycling stack,
+ *  so a queue running at a steady rate does not allocate. At most about
+ *  @a capacity nodes are kept, extra ones are freed.
+ *
+ *  An element is visible to the consumer once its producer has linked
+ *  it, a producer stalled between its two steps hides the elements
+ *  pushed after its own for that long.
+ *
+ *  @file forward_list_queue.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_QUEUE
+#define FORWARD_LIST_QUEUE
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "forward_list.h"
+
+struct Forward_List_Queue
+{
+    /* Producers side. */
+    _Atomic(Forward_List_Node*) head;       /* Last node linked. */
+    atomic_flag cache_lock;                 /* Tried, never waited for. */
+    Forward_List_Node* cache;               /* Recycled nodes taken by producers. */
+    /* Consumer side. */
+    Forward_List_Node* tail;                /* Consumed node, the next element follows it. */
+    /* Shared. */
+    _Atomic(Forward_List_Node*) recycled;   /* Pushed by the consumer, taken whole. */
+    atomic_size_t count;                    /* Elements queued or being pushed. */
+    atomic_size_t nodes;                    /* Nodes owned by the queue. */
+    size_t capacity;
+    size_t size;
+};
+
+typedef struct Forward_List_Queue Forward_List_Queue;
+
+/**
+ * @brief  Initializes the %forward_list_queue.
+ * @param  __queue     Points to %forward_list_queue object.
+ * @param  __size      Size of the elements.
+ * @param  __capacity  Maximum number of elements queued at once.
+ */
+extern void FWLQ_Init(Forward_List_Queue* __queue, size_t __size, size_t __capacity);
+
+/**
+ * @brief  Releases every node of the %forward_list_queue.
+ * @param  __queue   Points to %forward_list_queue object.
+ *
+ * No producer nor consumer may use the queue any more.
+ */
+extern void FWLQ_Destroy(Forward_List_Queue* __queue);
+
+/* Generic _FWLQ_push() */
+extern int _FWLQ_push(Forward_List_Queue* __queue, const void* __value);
+
+/**
+ * @brief  Add data to the end of the %forward_list_queue.
+ * @param _Tp       The data type used to initialize
+ *                  the %forward_list_queue.
+ * @param  __queue  Points to %forward_list_queue object.
+ * @param  ...      Data to be added.
+ * @return True if the data was queued, false if the queue is full.
+ *
+ * Lock-free, may be called by any number of threads at once.
+ */
+#define FWLQ_push(_Tp, __queue, ...)({             \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLQ_push(__queue, &__value);                 \
+})
+
+/**
+ * @brief  Add every element of a %forward_list to the end.
+ * @param  __queue     Points to %forward_list_queue object.
+ * @param  __src_list  A heap %forward_list of the same element size.
+ * @return True if the elements were queued, false if they do not fit,
+ *         in which case @a __src_list is left untouched.
+ *
+ * The nodes of @a __src_list are handed over at once, with one atomic
+ * exchange, and @a __src_list becomes an empty list.
+ */
+extern int FWLQ_push_list(Forward_List_Queue* __queue, Forward_List* __src_list);
+
+/**
+ * @brief  Removes first element, consumer thread only.
+ * @param  __queue  Points to %forward_list_queue object.
+ * @param  __out    Receives a copy of the element, may be NULL.
+ * @return True if an element was removed, false if none was visible.
+ */
+extern int FWLQ_pop(Forward_List_Queue* __queue, void* __out);
+
+/**
+ * @brief  Moves the first elements to a %forward_list, consumer thread only.
+ * @param  __queue  Points to %forward_list_queue object.
+ * @param  __list   A heap %forward_list of the same element size.
+ * @param  __max    Maximum number of elements moved.
+ * @return The number of elements moved.
+ *
+ * The elements are appended to @a __list in queue order, in nodes the
+ * queue hands over rather than copies, so no allocation takes place.
+ */
+extern size_t FWLQ_pop_list(Forward_List_Queue* __queue, Forward_List* __list, size_t __max);
+
+/**
+ * @brief  Returns the number of elements in the %forward_list_queue.
+ * @param  __queue   Points to %forward_list_queue object.
+ *
+ * While other threads use the queue this is only a snapshot, which may
+ * count elements still being pushed.
+ */
+extern size_t FWLQ_size(Forward_List_Queue* __queue);
+
+/**
+ * @brief  Returns true if no element is visible, consumer thread only.
+ * @param  __queue   Points to %forward_list_queue object.
+ */
+extern int FWLQ_empty(Forward_List_Queue* __queue);
+
+#endif
@@ -0,0 +1,194 @@
+/**
+ *  @brief A generic %forward_list for read-mostly data, iterated by any
+ *  number of threads without locks while a writer updates it.
+ *
+ *  Forward_List_RCU follows the read-copy-update pattern. Readers wrap
+ *  their walk in FWLR_read_lock() and FWLR_read_unlock(), which only
+ *  enter and leave an epoch (see forward_list_epoch.h), and follow the
+ *  links with FWLR_begin() and FWLR_next(). They never write shared
+ *  memory, so reader throughput grows with the number of cores.
+ *
+ *  Writers are serialized by a mutex. A new node is fully built before
+ *  a release store links it, and an erased node keeps its link, so a
+ *  reader standing on it still reaches the rest of the list. Erased
+ *  nodes are freed once every reader that could see them is gone.
+ *
+ *  Readers see each update at once or not at all, but a walk running
+ *  across several updates may see some of them only.
+ *
+ *  @file forward_list_rcu.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_RCU
+#define FORWARD_LIST_RCU
+
+#include <stddef.h>
+#include <pthread.h>
+#include "forward_list.h"
+
+struct Forward_List_RCU
+{
+    Forward_List_Node* start;       /* Stored with release, read with acquire. */
+    Forward_List_Node* finish;      /* Writers only. */
+    size_t count;                   /* Writers only. */
+    size_t size;
+    pthread_mutex_t lock;
+};
+
+typedef struct Forward_List_RCU Forward_List_RCU;
+
+/* Initializes the %forward_list_rcu. */
+extern void FWLR_Init(Forward_List_RCU* __list, size_t __size);
+
+/**
+ * @brief  Erases all the elements and releases the lock.
+ * @param  __list  Points to %forward_list_rcu object.
+ *
+ * No reader nor writer may use the list any more.
+ */
+extern void FWLR_Destroy(Forward_List_RCU* __list);
+
+/* Starts a read side critical section of the calling thread. */
+extern void FWLR_read_lock(void);
+
+/* Ends the read side critical section started last. */
+extern void FWLR_read_unlock(void);
+
+/**
+ * @brief  Returns the first node, or FWL_end() if the list is empty.
+ * @param  __list  Points to %forward_list_rcu object.
+ *
+ * The returned node and those reached from it with FWLR_next() stay
+ * valid until FWLR_read_unlock().
+ */
+extern FWL_iterator FWLR_begin(Forward_List_RCU* __list);
+
+/* Returns the node following __current, inside a read side critical section. */
+extern FWL_iterator FWLR_next(FWL_iterator __current);
+
+/* Points to the element of a node. */
+#define FWLR_value(__it) ((void *) (__it)->storage)
+
+/**
+ * @brief  Takes the writer lock for a sequence of updates.
+ * @param  __list  Points to %forward_list_rcu object.
+ *
+ * FWLR_before_begin(), FWLR_insert_after(), FWLR_replace_after() and
+ * FWLR_erase_after() must be called with the lock held, positions being
+ * found under the same lock. The other updates take it themselves.
+ */
+extern void FWLR_write_lock(Forward_List_RCU* __list);
+
+/* Releases the writer lock. */
+extern void FWLR_write_unlock(Forward_List_RCU* __list);
+
+/* Returns the position before the first node, writer lock held. */
+extern FWL_iterator FWLR_before_begin(Forward_List_RCU* __list);
+
+/* Generic _FWLR_insert_after() */
+extern FWL_iterator _FWLR_insert_after(Forward_List_RCU* __list, FWL_iterator __position, const void* __value);
+
+/**
+ * @brief  Inserts a value after the specified position, writer lock held.
+ * @param _Tp         The data type used to initialize
+ *                    the %forward_list_rcu.
+ * @param  __list     Points to %forward_list_rcu object.
+ * @param  __position A node of the list or FWLR_before_begin().
+ * @param  ...        Data to be inserted.
+ * @return The new node.
+ */
+#define FWLR_insert_after(_Tp, __list, __position, ...)({          \
+   _Tp __value = (_Tp)__VA_ARGS__;                                 \
+    _FWLR_insert_after(__list, __position, &__value);              \
+})
+
+/* Generic _FWLR_replace_after() */
+extern FWL_iterator _FWLR_replace_after(Forward_List_RCU* __list, FWL_iterator __position, const void* __value);
+
+/**
+ * @brief  Replaces the element after the specified position, writer lock held.
+ * @param _Tp         The data type used to initialize
+ *                    the %forward_list_rcu.
+ * @param  __list     Points to %forward_list_rcu object.
+ * @param  __position Node before the element to be replaced.
+ * @param  ...        New value of the element.
+ * @return The new node.
+ *
+ * The element is copied into a new node linked in place of the old one
+ * with a single store, readers see either value but never a mix.
+ */
+#define FWLR_replace_after(_Tp, __list, __position, ...)({         \
+   _Tp __value = (_Tp)__VA_ARGS__;                                 \
+    _FWLR_replace_after(__list, __position, &__value);             \
+})
+
+/**
+ * @brief  Erases the element after the specified position, writer lock held.
+ * @param  __list     Points to %forward_list_rcu object.
+ * @param  __position Node before the element to be erased.
+ * @return The node following the erased one.
+ */
+extern FWL_iterator FWLR_erase_after(Forward_List_RCU* __list, FWL_iterator __position);
+
+/* Generic _FWLR_push_front() */
+extern void _FWLR_push_front(Forward_List_RCU* __list, const void* __value);
+
+/**
+ * @brief  Add data to the front of the %forward_list_rcu.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_rcu.
+ * @param  __list  Points to %forward_list_rcu object.
+ * @param  ...     Data to be added.
+ */
+#define FWLR_push_front(_Tp, __list, ...)({        \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLR_push_front(__list, &__value);            \
+})
+
+/* Generic _FWLR_push_back() */
+extern void _FWLR_push_back(Forward_List_RCU* __list, const void* __value);
+
+/**
+ * @brief  Add data to the end of the %forward_list_rcu.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_rcu.
+ * @param  __list  Points to %forward_list_rcu object.
+ * @param  ...     Data to be added.
+ */
+#define FWLR_push_back(_Tp, __list, ...)({         \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLR_push_back(__list, &__value);             \
+})
+
+/**
+ * @brief  Remove all elements satisfying a predicate.
+ * @param  __list       Points to %forward_list_rcu object.
+ * @param  __predicate  Unary predicate function.
+ * @return The number of elements removed.
+ */
+extern size_t FWLR_remove_if(Forward_List_RCU* __list, int (*__predicate)(const void *));
+
+/**
+ * @brief  Moves every element of a %forward_list to the end.
+ * @param  __list      Points to %forward_list_rcu object.
+ * @param  __src_list  A heap %forward_list of the same element size,
+ *                     left empty.
+ *
+ * The nodes of @a __src_list are published at once with one store.
+ */
+extern void FWLR_splice_back(Forward_List_RCU* __list, Forward_List* __src_list);
+
+/**
+ * @brief  Returns the number of elements in the %forward_list_rcu.
+ * @param  __list   Points to %forward_list_rcu object.
+ */
+extern size_t FWLR_size(Forward_List_RCU* __list);
+
+/**
+ * @brief  Erases all the elements.
+ * @param  __list   Points to %forward_list_rcu object.
+ */
+extern void FWLR_clear(Forward_List_RCU* __list);
+
+#endif
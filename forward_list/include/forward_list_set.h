@@ -0,0 +1,121 @@
+/**
+ *  @brief A generic sorted set of unique elements that many threads can
+ *  update and search at once without locks.
+ *
+ *  Forward_List_Set is a Harris style lock-free ordered list of ordinary
+ *  Forward_List_Node nodes. An element is erased in two steps: the low
+ *  bit of its @c next link is set first, which marks it logically
+ *  deleted and freezes the link, then the node is unlinked by whichever
+ *  thread gets there first, the eraser or a later traversal helping it.
+ *  Unlinked nodes are released through epoch based reclamation (see
+ *  forward_list_epoch.h).
+ *
+ *  FWLS_contains() never writes shared memory nor retries, so it makes
+ *  progress whatever other threads do. FWLS_insert() and FWLS_erase()
+ *  are lock-free.
+ *
+ *  Elements are ordered by a comparison function with the convention of
+ *  FWL_sort(), two elements being equal when neither goes after the
+ *  other.
+ *
+ *  @file forward_list_set.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_SET
+#define FORWARD_LIST_SET
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "forward_list.h"
+
+struct Forward_List_Set
+{
+    Forward_List_Node* start;       /* Only accessed atomically. */
+    atomic_size_t count;
+    size_t size;
+    int (*compare)(const void *, const void *);
+};
+
+typedef struct Forward_List_Set Forward_List_Set;
+
+/**
+ * @brief  Initializes the %forward_list_set.
+ * @param  __set      Points to %forward_list_set object.
+ * @param  __size     Size of the elements.
+ * @param  __compare  Comparison function, same convention as FWL_sort().
+ */
+extern void FWLS_Init(Forward_List_Set* __set, size_t __size, int (*__compare)(const void *, const void *));
+
+/* Generic _FWLS_insert() */
+extern int _FWLS_insert(Forward_List_Set* __set, const void* __value);
+
+/**
+ * @brief  Adds a value to the %forward_list_set.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_set.
+ * @param  __set   Points to %forward_list_set object.
+ * @param  ...     Value to be added.
+ * @return True if the value was added, false if an equal one was there.
+ */
+#define FWLS_insert(_Tp, __set, ...)({             \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLS_insert(__set, &__value);                 \
+})
+
+/* Generic _FWLS_erase() */
+extern int _FWLS_erase(Forward_List_Set* __set, const void* __value);
+
+/**
+ * @brief  Removes a value from the %forward_list_set.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_set.
+ * @param  __set   Points to %forward_list_set object.
+ * @param  ...     Value to be removed.
+ * @return True if an equal element was removed by this call.
+ */
+#define FWLS_erase(_Tp, __set, ...)({              \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLS_erase(__set, &__value);                  \
+})
+
+/* Generic _FWLS_contains() */
+extern int _FWLS_contains(Forward_List_Set* __set, const void* __value);
+
+/**
+ * @brief  Looks a value up in the %forward_list_set.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_set.
+ * @param  __set   Points to %forward_list_set object.
+ * @param  ...     Value to search for.
+ * @return True if an equal element is in the set.
+ */
+#define FWLS_contains(_Tp, __set, ...)({           \
+   _Tp __value = (_Tp)__VA_ARGS__;                 \
+    _FWLS_contains(__set, &__value);               \
+})
+
+/**
+ * @brief  Returns the number of elements in the %forward_list_set.
+ * @param  __set   Points to %forward_list_set object.
+ *
+ * While other threads modify the set this is only a snapshot.
+ */
+extern size_t FWLS_size(Forward_List_Set* __set);
+
+/**
+ * @brief  Returns true if the %forward_list_set is empty.
+ * @param  __set   Points to %forward_list_set object.
+ */
+extern int FWLS_empty(Forward_List_Set* __set);
+
+/**
+ * @brief  Erases all the elements.
+ * @param  __set   Points to %forward_list_set object.
+ *
+ * Not safe against concurrent updates. Concurrent lookups are allowed,
+ * the nodes are retired rather than freed.
+ */
+extern void FWLS_clear(Forward_List_Set* __set);
+
+#endif
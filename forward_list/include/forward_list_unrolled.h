@@ -0,0 +1,274 @@
+/**
+ *  @brief A generic unrolled %forward_list that packs several elements
+ *  into every node.
+ *
+ *  Each node of a Forward_List_Unrolled holds up to @c capacity elements
+ *  stored contiguously, where @c capacity is derived from the element
+ *  size so that a node spans about two cache lines. Scans such as
+ *  FWLU_remove_if(), FWLU_unique() and FWLU_for_each() therefore stream
+ *  through memory instead of chasing one pointer per element.
+ *
+ *  Nodes are split when an insertion hits a full node and merged with
+ *  their successor when erasing leaves them less than half full. Both
+ *  operations move elements, so unlike Forward_List every insertion or
+ *  erasure invalidates the iterators into the affected nodes.
+ *
+ *  Iteration is done as follows:
+ *
+ *      for(FWLU_iterator it = FWLU_begin(&list); !FWLU_is_end(it); it = FWLU_next(it))
+ *
+ *  @file forward_list_unrolled.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_UNROLLED
+#define FORWARD_LIST_UNROLLED
+
+#include <stddef.h>
+#include "forward_list.h"
+
+struct Forward_List_Unrolled_Node
+{
+    struct Forward_List_Unrolled_Node* next;
+    size_t used;
+    Forward_List_Generic storage[];
+};
+
+typedef struct Forward_List_Unrolled_Node Forward_List_Unrolled_Node;
+
+struct FWLU_iterator
+{
+    Forward_List_Unrolled_Node* node;
+    size_t index;
+};
+
+typedef struct FWLU_iterator FWLU_iterator;
+
+/*
+ * start and start_used overlay the next and used fields of a node, so
+ * the list itself serves as an empty node before the first one.
+ */
+struct Forward_List_Unrolled
+{
+    Forward_List_Unrolled_Node* start;
+    size_t start_used;   /* Always zero. */
+    Forward_List_Unrolled_Node* finish;
+    size_t count;
+    size_t size;
+    size_t capacity;   /* Elements per node. */
+};
+
+typedef struct Forward_List_Unrolled Forward_List_Unrolled;
+
+/**
+ * @brief  Generic pointer to the element referenced by an iterator.
+ * @param  __list  Points to %forward_list_unrolled object.
+ * @param  __iter  An iterator into the %forward_list_unrolled.
+ */
+#define FWLU_storage(__list, __iter)  ((void*) ((__iter).node->storage + (__iter).index * (__list)->size))
+
+/**
+ * @brief  Cast generic type into true data type.
+ * @param  _Tp     The data type used to initialize
+ *                 the %forward_list_unrolled.
+ * @param  __iter  An Iterator into %forward_list_unrolled.
+ */
+#define FWLU_cast(_Tp, __iter)  (((_Tp*) (__iter).node->storage)[(__iter).index])
+
+/**
+ * @param  __iter  An Iterator into %forward_list_unrolled.
+ * @return An iterator to the following element.
+ */
+#define FWLU_next(__iter) ({                         \
+    FWLU_iterator __next = (__iter);                 \
+    if(++__next.index >= __next.node->used){         \
+        __next.node = __next.node->next;             \
+        __next.index = 0;                            \
+    }                                                \
+    __next;                                          \
+})
+
+/* Returns true if the iterator is past the last element. */
+#define FWLU_is_end(__iter)  ((__iter).node == NULL)
+
+/**
+ * @brief  Initializes the %forward_list_unrolled.
+ * @param  _Tp  Type of the data to be stored.
+ * @param  ...  The provided initializer list.
+ */
+#define FWLU_init(_Tp, ...) ({                               \
+   _Tp __buffer[] = __VA_ARGS__;                             \
+    size_t __size = sizeof(__buffer)/sizeof(_Tp);            \
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(_Tp));   \
+    for (size_t __i = 0; __i < __size; ++__i){               \
+        FWLU_push_back(_Tp, &__list, __buffer[__i]);         \
+    }                                                        \
+    __list;                                                  \
+})
+
+/* Initializes the %forward_list_unrolled. */
+extern Forward_List_Unrolled FWLU_Init(size_t __size);
+
+/**
+ * @param __list Points to %forward_list_unrolled object.
+ *
+ * Returns an iterator that points before the first element.
+ */
+extern FWLU_iterator FWLU_before_begin(Forward_List_Unrolled* __list);
+
+/**
+ * @param __list Points to %forward_list_unrolled object.
+ *
+ * Returns an iterator that points to the first element.
+ */
+extern FWLU_iterator FWLU_begin(Forward_List_Unrolled* __list);
+
+/**
+ * @param __list Points to %forward_list_unrolled object.
+ *
+ * Returns an iterator that points to the last element, or before the
+ * first element if the %forward_list_unrolled is empty.
+ */
+extern FWLU_iterator FWLU_rbegin(Forward_List_Unrolled* __list);
+
+/* Generic _FWLU_insert_after() */
+extern FWLU_iterator _FWLU_insert_after(Forward_List_Unrolled* __list, FWLU_iterator __position, void** __storage);
+
+/**
+ * @brief Inserts given value after specified iterator.
+ * @param _Tp           The data type used to initialize
+ *                      the %forward_list_unrolled.
+ * @param  __list       Points to a %forward_list_unrolled object.
+ * @param  __position   An iterator into the %forward_list_unrolled.
+ * @param ...           Data to be inserted.
+ * @return An iterator that points to the inserted data.
+ *
+ * If the node of @a __position is full it is split in two first.
+ */
+#define FWLU_insert_after(_Tp, __list, __position, ...)({                              \
+   _Tp* __storage = NULL;                                                              \
+    FWLU_iterator __ret = _FWLU_insert_after(__list, __position, (void**)& __storage); \
+    *__storage = (_Tp)__VA_ARGS__;                                                     \
+    __ret;                                                                             \
+})
+
+/**
+ * @brief  Add data to the end of the %forward_list_unrolled.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_unrolled.
+ * @param  __list  Points to %forward_list_unrolled object.
+ * @param  ...     Data to be added.
+ */
+#define FWLU_push_back(_Tp, __list, ...) ({                             \
+    FWLU_insert_after(_Tp, __list, FWLU_rbegin(__list), __VA_ARGS__);   \
+})
+
+/**
+ * @brief  Add data to the front of the %forward_list_unrolled.
+ * @param _Tp      The data type used to initialize
+ *                 the %forward_list_unrolled.
+ * @param  __list  Points to %forward_list_unrolled object.
+ * @param  ...     Data to be added.
+ */
+#define FWLU_push_front(_Tp, __list, ...) ({                                 \
+    FWLU_insert_after(_Tp, __list, FWLU_before_begin(__list), __VA_ARGS__);  \
+})
+
+/**
+ * @brief  Removes first element.
+ * @param __list Points to %forward_list_unrolled object.
+ */
+extern void FWLU_pop_front(Forward_List_Unrolled* __list);
+
+/**
+ * @brief  Removes the element following position.
+ * @param  __list       Points to %forward_list_unrolled object.
+ * @param  __position   An iterator pointing before the element to be erased.
+ * @return An iterator pointing to the element following the one that was
+ *         erased, or an end iterator if no such element exists.
+ */
+extern FWLU_iterator FWLU_pop_after(Forward_List_Unrolled* __list, FWLU_iterator __position);
+
+/**
+ * @brief  Removes a number of elements.
+ * @param  __list   Points to %forward_list_unrolled object.
+ * @param  __before An iterator pointing before the first element to be erased.
+ * @param  __n      Number of elements to erase.
+ * @return An iterator pointing to the element following the erased ones.
+ *
+ * Elements are removed a node at a time, so this is linear in the number
+ * of nodes touched rather than the number of elements.
+ */
+extern FWLU_iterator FWLU_erase_after(Forward_List_Unrolled* __list, FWLU_iterator __before, size_t __n);
+
+/**
+ *  @brief  Insert contents of another %forward_list_unrolled.
+ *  @param  __list      Points to %forward_list_unrolled object.
+ *  @param  __position  Iterator referencing the element to insert after.
+ *  @param  __src_list  Source list, of the same element size.
+ *
+ *  The node of @a __position is split after it and the nodes of
+ *  @a __src_list are linked in between, so no more than one node worth
+ *  of elements is moved. @a __src_list becomes an empty list.
+ */
+extern void FWLU_splice_after_list(Forward_List_Unrolled* __list, FWLU_iterator __position, Forward_List_Unrolled* __src_list);
+
+/**
+ *  @brief  Insert range from another %forward_list_unrolled.
+ *  @param  __list      Points to %forward_list_unrolled object.
+ *  @param  __position  Iterator referencing the element to insert after.
+ *  @param  __src_list  Source list, distinct from @a __list.
+ *  @param  __before    Iterator referencing before the start of range
+ *                      in source list.
+ *  @param  __n         Number of elements in the range.
+ *
+ *  The source nodes are split at both ends of the range and the nodes in
+ *  between are relinked.
+ */
+extern void FWLU_splice_after_range(Forward_List_Unrolled* __list, FWLU_iterator __position, Forward_List_Unrolled* __src_list,
+                                                                   FWLU_iterator __before, size_t __n);
+
+/**
+ * @brief  Calls a function on every element, in list order.
+ * @param  __list  Points to %forward_list_unrolled object.
+ * @param  __fn    Function receiving each element and @a __ctx.
+ * @param  __ctx   User data passed through to @a __fn.
+ */
+extern void FWLU_for_each(Forward_List_Unrolled* __list, void (*__fn)(void *, void *), void* __ctx);
+
+/**
+ *  @brief  Removes all elements satisfying a predicate.
+ *  @param  __list       Points to %forward_list_unrolled object.
+ *  @param  __predicate  Unary predicate function.
+ *
+ *  Each node is compacted in place, emptied nodes are released and
+ *  sparse neighbours are merged. Remaining elements stay in list order.
+ */
+extern void FWLU_remove_if(Forward_List_Unrolled* __list, int (*__predicate)(const void *));
+
+/**
+ * @brief  Removes consecutive duplicate elements according to comparison function.
+ * @param  __list     Points to %forward_list_unrolled object.
+ * @param  __compare  Comparison function, returns true for equal elements.
+ */
+extern void FWLU_unique(Forward_List_Unrolled* __list, int (*__compare)(const void *, const void *));
+
+/**
+ * @brief  Returns true if the %forward_list_unrolled is empty.
+ * @param  __list   Points to %forward_list_unrolled object.
+ */
+extern int FWLU_empty(Forward_List_Unrolled* __list);
+
+/**
+ * @brief  Returns the number of elements in the %forward_list_unrolled.
+ * @param  __list   Points to %forward_list_unrolled object.
+ */
+extern size_t FWLU_size(Forward_List_Unrolled* __list);
+
+/**
+ * @brief  Erases all the elements.
+ * @param  __list   Points to %forward_list_unrolled object.
+ */
+extern void FWLU_clear(Forward_List_Unrolled* __list);
+
+#endif
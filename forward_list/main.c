@@ -73,8 +73,9 @@ int main(void)
     /* Initializes the %forward_list 'test3' */
     Forward_List test3 = FWL_init(char*, {"Battle", "C", "Apple", "Camel", "B", "A"});
 
-    /* Sorts the elements in the %forward_list 'test3' */
-    FWL_sort(&test3, compare);
+    /* Sorts the elements in the %forward_list 'test3', most comparisons are
+       settled by the first 8 bytes of the strings without calling 'compare' */
+    FWL_sort_prefixed(&test3, compare, FWL_string_prefix);
 
     /* Displays the data stored in the %forward_list 'test3' after sorting */
     for(FWL_iterator it = FWL_begin(&test3); it != FWL_end(&test3); it = it->next)
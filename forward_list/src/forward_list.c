@@ -1,7 +1,50 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
 #include "../include/forward_list.h"
 
+/* Default slab size of an arena backed %forward_list. */
+#define FWL_ARENA_SLAB_BYTES (64 * 1024)
+
+/* Largest node served by the pool, bigger nodes use calloc()/free(). */
+#define FWL_POOL_MAX_NODE 512
+#define FWL_POOL_CLASSES  (FWL_POOL_MAX_NODE / sizeof(Forward_List_Node))
+
+/* Number of nodes in a magazine, the unit exchanged with the depot. */
+#define FWL_POOL_MAGAZINE 128
+
+/* Lists shorter than this per thread are sorted or walked sequentially. */
+#define FWL_PARALLEL_MIN_NODES 8192
+
+/* Chunks per thread of a parallel walk, spare ones get stolen. */
+#define FWL_PARALLEL_CHUNKS 4
+
+/* Most threads a batch runs on, the caller included, each with a range of tasks of its own. */
+#define FWL_WORKERS_MAX_SLOTS 64
+
+/* Index entries whose nodes are requested ahead of a traversal. */
+#define FWL_PREFETCH_DISTANCE 8
+
+/* Levels of the skip list of a sorted list. */
+#define FWL_SKIP_MAX_LEVEL 24
+
+/* Lists at least this long are sorted through an array of node pointers. */
+#define FWL_SORT_ARRAY_MIN 4096
+
+/* Blocks of the pointer array first sorted by insertion. */
+#define FWL_SORT_ARRAY_BLOCK 32
+
+static void FWL_put_node(Forward_List* __list, Forward_List_Node* __node);
+static FWL_iterator FWL_put_chain(Forward_List* __list, Forward_List_Node* __first, FWL_iterator __stop, size_t* __n);
+static void FWL_invalidate(Forward_List* __list);
+static void FWL_index_append(Forward_List* __list, Forward_List_Node* __node);
+static int FWL_index_ready(Forward_List* __list);
+
+/* Address of the element of a node, the node storage or the structure embedding it. */
+#define FWL_value(__list, __node) ((void*) ((char*) (__node) + (__list)->offset))
+
 FWL_iterator FWL_advance(FWL_iterator __current, size_t __n)
 {
     for(; __n; --__n)
@@ -47,12 +90,12 @@ FWL_iterator FWL_end(Forward_List* __list)
 
 void* _FWL_front(Forward_List* __list)
 {
-    return FWL_begin(__list)->storage;
+    return FWL_value(__list, FWL_begin(__list));
 }
 
 void* _FWL_back(Forward_List* __list)
 {
-    return FWL_rbegin(__list)->storage;
+    return FWL_value(__list, FWL_rbegin(__list));
 }
 
 static FWL_iterator FWL_pop_first_element(Forward_List* __list)
@@ -63,7 +106,8 @@ static FWL_iterator FWL_pop_first_element(Forward_List* __list)
     {
         __list->finish = __list->start;
     }
-    free(__temp);
+    FWL_invalidate(__list);
+    FWL_put_node(__list, __temp);
     return __list->start;
 }
 
@@ -78,21 +122,32 @@ void FWL_pop_front(Forward_List* __list)
 
 void FWL_pop_back(Forward_List* __list)
 {
+    if(__list->index.stride && __list->count > 1)
+    {
+        FWL_pop_after(__list, FWL_at(__list, __list->count - 2));
+        return;
+    }
     FWL_pop_after(__list, FWL_advance(FWL_before_begin(__list), FWL_size(__list)-1));
 }
 
 static void FWL_pop_last_element(Forward_List* __list, FWL_iterator __position)
 {
-    free(__list->finish);
+    FWL_put_node(__list, __list->finish);
     __position->next = NULL;
     __list->finish = __position;
+    if(__list->index.valid && (__list->count - 1) % __list->index.stride == 0)
+    {
+        --__list->index.length;
+    }
+    __list->skip.valid = 0;
 }
 
-static FWL_iterator FWL_pop_next_element(FWL_iterator __position)
+static FWL_iterator FWL_pop_next_element(Forward_List* __list, FWL_iterator __position)
 {
         Forward_List_Node* __temp = __position->next;
         __position->next = __position->next->next;
-        free(__temp);
+        FWL_put_node(__list, __temp);
+        FWL_invalidate(__list);
         return __position;
 }
 
@@ -113,7 +168,7 @@ FWL_iterator FWL_pop_after(Forward_List* __list, FWL_iterator __position)
     }
     else if(__position->next->next)
     {
-        __ret = FWL_pop_next_element(__position);
+        __ret = FWL_pop_next_element(__list, __position);
     }
     else {}
     --__list->count;
@@ -126,391 +181,2261 @@ static void FWL_exit(const char* __func_name)
     exit(EXIT_FAILURE);
 }
 
-static Forward_List_Node* FWL_get_node(Forward_List* __list)
+/* Size of one node, rounded so that consecutive nodes stay aligned. */
+static size_t FWL_node_size(size_t __size)
 {
-    Forward_List_Node* __node = (Forward_List_Node*) calloc(1, sizeof(Forward_List_Node*) + __list->size);
-    if(!__node)
+    size_t __align = _Alignof(Forward_List_Node);
+    return (sizeof(Forward_List_Node) + __size + __align - 1) / __align * __align;
+}
+
+/* Slabs start with a link to the previous slab, padded to keep nodes aligned. */
+#define FWL_SLAB_HEADER FWL_node_size(0)
+
+/* Starts a new slab of at least __nodes nodes. */
+static int FWL_arena_grow(Forward_List* __list, size_t __nodes)
+{
+    Forward_List_Arena* __arena = &__list->arena;
+    size_t __node_size = FWL_node_size(__list->size);
+    if(__nodes < __arena->slab_nodes)
     {
-        FWL_clear(__list);
-        FWL_exit("FWL_get_node()");
+        __nodes = __arena->slab_nodes;
     }
-    return __node;
+    void** __slab = (void**) malloc(FWL_SLAB_HEADER + __nodes * __node_size);
+    if(!__slab)
+    {
+        return 0;
+    }
+    *__slab = __arena->slabs;
+    __arena->slabs = __slab;
+    __arena->bump = (Forward_List_Generic*) __slab + FWL_SLAB_HEADER;
+    __arena->bump_end = __arena->bump + __nodes * __node_size;
+    return 1;
 }
 
-static void FWL_init_list(Forward_List* __list, Forward_List_Node* __node)
+static Forward_List_Node* FWL_arena_get_node(Forward_List* __list)
 {
+    Forward_List_Arena* __arena = &__list->arena;
+    Forward_List_Node* __node = __arena->free_nodes;
+    if(__node)
+    {
+        __arena->free_nodes = __node->next;
+    }
+    else
+    {
+        if(__arena->bump == __arena->bump_end && !FWL_arena_grow(__list, 1))
+        {
+            return NULL;
+        }
+        __node = (Forward_List_Node*) __arena->bump;
+        __arena->bump += FWL_node_size(__list->size);
+    }
     __node->next = NULL;
-    __list->start = __node;
-    __list->finish = __node;
+    memset(__node->storage, 0, __list->size);
+    return __node;
 }
 
-static void FWL_insert_before_begin(Forward_List* __list, Forward_List_Node* __node)
+/* Drops every slab of the arena at once, the nodes are not visited. */
+static void FWL_arena_release(Forward_List_Arena* __arena)
 {
-    __node->next = __list->start;
-    __list->start = __node;
+    void** __slab = (void**) __arena->slabs;
+    void** __prev = NULL;
+    while(__slab)
+    {
+        __prev = (void**) *__slab;
+        free(__slab);
+        __slab = __prev;
+    }
+    __arena->slabs = NULL;
+    __arena->free_nodes = NULL;
+    __arena->bump = NULL;
+    __arena->bump_end = NULL;
 }
 
-static void __FWL_insert_after(Forward_List* __list, FWL_iterator __position, Forward_List_Node* __node)
+/*
+ * Process-wide node pool.
+ *
+ * Every thread owns one cache per size class, a plain singly linked
+ * chain of free nodes that is only touched by that thread. When a cache
+ * runs dry it takes a whole magazine from the shared depot, and when it
+ * holds two magazines worth of nodes it hands one back. Magazines in the
+ * depot are chained through the storage of their first node, which is
+ * always large enough to hold a pointer.
+ */
+struct FWL_Pool_Cache
 {
-    __node->next = __position->next;
-    if(__node->next == NULL)
+    Forward_List_Node* head[FWL_POOL_CLASSES];
+    size_t length[FWL_POOL_CLASSES];
+    size_t hits;
+    size_t misses;
+    int registered;
+};
+
+static _Thread_local struct FWL_Pool_Cache FWL_pool_cache;
+
+static pthread_mutex_t FWL_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t FWL_pool_once = PTHREAD_ONCE_INIT;
+static pthread_key_t FWL_pool_key;
+static Forward_List_Node* FWL_pool_depot[FWL_POOL_CLASSES];
+static size_t FWL_pool_depot_nodes;
+static size_t FWL_pool_hits;
+static size_t FWL_pool_misses;
+
+/* Size class of the nodes of a %forward_list or FWL_POOL_CLASSES if none. */
+static size_t FWL_pool_class(size_t __size)
+{
+    size_t __node_size = FWL_node_size(__size);
+    if(__size == 0 || __node_size > FWL_POOL_MAX_NODE)
     {
-        __list->finish = __node;
+        return FWL_POOL_CLASSES;
     }
-    __position->next = __node;
+    return __node_size / sizeof(Forward_List_Node) - 1;
 }
 
-FWL_iterator _FWL_insert_after(Forward_List* __list, FWL_iterator __position, void** __storage)
+#define FWL_MAGAZINE_LINK(__node) (*(Forward_List_Node**) (__node)->storage)
+
+/* Must be called with FWL_pool_lock held. */
+static void FWL_pool_flush_counters(struct FWL_Pool_Cache* __cache)
 {
-    Forward_List_Node* __node = FWL_get_node(__list);
-    if(__list->start == NULL)
+    FWL_pool_hits += __cache->hits;
+    FWL_pool_misses += __cache->misses;
+    __cache->hits = 0;
+    __cache->misses = 0;
+}
+
+/* Moves the first FWL_POOL_MAGAZINE nodes of a cache into the depot. */
+static void FWL_pool_spill(struct FWL_Pool_Cache* __cache, size_t __class)
+{
+    Forward_List_Node* __first = __cache->head[__class];
+    Forward_List_Node* __last = __first;
+    for (size_t __i = 1; __i < FWL_POOL_MAGAZINE; ++__i)
     {
-        FWL_init_list(__list, __node);
+        __last = __last->next;
     }
-    else
+    __cache->head[__class] = __last->next;
+    __cache->length[__class] -= FWL_POOL_MAGAZINE;
+    __last->next = NULL;
+
+    pthread_mutex_lock(&FWL_pool_lock);
+    FWL_MAGAZINE_LINK(__first) = FWL_pool_depot[__class];
+    FWL_pool_depot[__class] = __first;
+    FWL_pool_depot_nodes += FWL_POOL_MAGAZINE;
+    FWL_pool_flush_counters(__cache);
+    pthread_mutex_unlock(&FWL_pool_lock);
+}
+
+/* Refills an empty cache with a magazine from the depot, if there is one. */
+static void FWL_pool_refill(struct FWL_Pool_Cache* __cache, size_t __class)
+{
+    pthread_mutex_lock(&FWL_pool_lock);
+    Forward_List_Node* __magazine = FWL_pool_depot[__class];
+    if(__magazine)
     {
-        if(__position == FWL_before_begin(__list))
+        FWL_pool_depot[__class] = FWL_MAGAZINE_LINK(__magazine);
+        FWL_pool_depot_nodes -= FWL_POOL_MAGAZINE;
+        __cache->head[__class] = __magazine;
+        __cache->length[__class] = FWL_POOL_MAGAZINE;
+    }
+    FWL_pool_flush_counters(__cache);
+    pthread_mutex_unlock(&FWL_pool_lock);
+}
+
+/* Hands the cache of an exiting thread back to the depot. */
+static void FWL_pool_thread_exit(void* __arg)
+{
+    struct FWL_Pool_Cache* __cache = &FWL_pool_cache;
+    (void) __arg;
+    for (size_t __class = 0; __class < FWL_POOL_CLASSES; ++__class)
+    {
+        while(__cache->length[__class] >= FWL_POOL_MAGAZINE)
         {
-            FWL_insert_before_begin(__list, __node);
+            FWL_pool_spill(__cache, __class);
         }
-        else
+        Forward_List_Node* __node = __cache->head[__class];
+        while(__node)
         {
-            __FWL_insert_after(__list, __position, __node);
+            Forward_List_Node* __next = __node->next;
+            free(__node);
+            __node = __next;
         }
+        __cache->head[__class] = NULL;
+        __cache->length[__class] = 0;
     }
-    *__storage = __node->storage;
-    ++__list->count;
-    return __node;
+    pthread_mutex_lock(&FWL_pool_lock);
+    FWL_pool_flush_counters(__cache);
+    pthread_mutex_unlock(&FWL_pool_lock);
 }
 
-static void FWL_reset(Forward_List* __list)
+static void FWL_pool_make_key(void)
 {
-    __list->start = NULL;
-    __list->finish = NULL;
-    __list->count = 0;
+    pthread_key_create(&FWL_pool_key, FWL_pool_thread_exit);
 }
 
-void FWL_splice_after_list(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list)
+static void FWL_pool_register(struct FWL_Pool_Cache* __cache)
 {
-    if(__position == NULL)
-    {
-        return;
-    }
-    if(FWL_empty(__list))
+    pthread_once(&FWL_pool_once, FWL_pool_make_key);
+    pthread_setspecific(FWL_pool_key, __cache);
+    __cache->registered = 1;
+}
+
+static Forward_List_Node* FWL_pool_get_node(size_t __size)
+{
+    size_t __class = FWL_pool_class(__size);
+    if(__class == FWL_POOL_CLASSES)
     {
-        __list->start = __src_list->start;
-        __list->finish = __src_list->finish;
+        return (Forward_List_Node*) calloc(1, sizeof(Forward_List_Node*) + __size);
     }
-    else if(__position == FWL_before_begin(__list))
+    struct FWL_Pool_Cache* __cache = &FWL_pool_cache;
+    if(!__cache->registered)
     {
-        __src_list->finish->next = __list->start;
-        __list->start = __src_list->start;
+        FWL_pool_register(__cache);
     }
-    else if(__position == FWL_rbegin(__list))
+    if(!__cache->head[__class])
     {
-        __list->finish->next = __src_list->start;
-        __list->finish = __src_list->finish;
+        FWL_pool_refill(__cache, __class);
     }
-    else
+    Forward_List_Node* __node = __cache->head[__class];
+    if(__node)
     {
-        __src_list->finish->next = __position->next;
-        __position->next = __src_list->start;
+        __cache->head[__class] = __node->next;
+        --__cache->length[__class];
+        ++__cache->hits;
+        __node->next = NULL;
+        memset(__node->storage, 0, __size);
+        return __node;
     }
-
-    __list->count += __src_list->count;
-
-    FWL_reset(__src_list);
+    ++__cache->misses;
+    return (Forward_List_Node*) calloc(1, FWL_node_size(__size));
 }
 
-static Forward_List_Node* FWL_unlink_node(Forward_List* __src_list, FWL_iterator __i)
+static void FWL_pool_put_node(size_t __size, Forward_List_Node* __node)
 {
-    Forward_List_Node* __node = NULL;
-    if(__i->next)
+    size_t __class = FWL_pool_class(__size);
+    if(__class == FWL_POOL_CLASSES)
     {
-        __node = __i->next;
+        free(__node);
+        return;
     }
-    else
+    struct FWL_Pool_Cache* __cache = &FWL_pool_cache;
+    if(!__cache->registered)
     {
-        return NULL;
+        FWL_pool_register(__cache);
     }
-    if(__i == FWL_before_begin(__src_list))
+    __node->next = __cache->head[__class];
+    __cache->head[__class] = __node;
+    if(++__cache->length[__class] >= 2 * FWL_POOL_MAGAZINE)
     {
-        __src_list->start = __src_list->start->next;
-        if(__src_list->start == FWL_end(__src_list))
+        FWL_pool_spill(__cache, __class);
+    }
+}
+
+/* Pushes a chain of __n linked nodes ending at __tail onto the cache at once. */
+static void FWL_pool_put_chain(size_t __size, Forward_List_Node* __first, Forward_List_Node* __tail, size_t __n)
+{
+    size_t __class = FWL_pool_class(__size);
+    if(__class == FWL_POOL_CLASSES)
+    {
+        for (Forward_List_Node* __next = NULL; __n; --__n, __first = __next)
         {
-            __src_list->finish = __src_list->start;
+            __next = __first->next;
+            free(__first);
         }
+        return;
     }
-    else if(__i->next == FWL_rbegin(__src_list))
+    struct FWL_Pool_Cache* __cache = &FWL_pool_cache;
+    if(!__cache->registered)
     {
-        __src_list->finish = __i;
-        __src_list->finish->next = NULL;
+        FWL_pool_register(__cache);
     }
-    else
+    __tail->next = __cache->head[__class];
+    __cache->head[__class] = __first;
+    __cache->length[__class] += __n;
+    while(__cache->length[__class] >= 2 * FWL_POOL_MAGAZINE)
     {
-        if(__i->next)
+        FWL_pool_spill(__cache, __class);
+    }
+}
+
+void FWL_pool_stats(Forward_List_Pool_Stats* __stats)
+{
+    pthread_mutex_lock(&FWL_pool_lock);
+    FWL_pool_flush_counters(&FWL_pool_cache);
+    __stats->hits = FWL_pool_hits;
+    __stats->misses = FWL_pool_misses;
+    __stats->cached = FWL_pool_depot_nodes;
+    pthread_mutex_unlock(&FWL_pool_lock);
+}
+
+void FWL_pool_trim(void)
+{
+    struct FWL_Pool_Cache* __cache = &FWL_pool_cache;
+    Forward_List_Node* __depot[FWL_POOL_CLASSES];
+    pthread_mutex_lock(&FWL_pool_lock);
+    for (size_t __class = 0; __class < FWL_POOL_CLASSES; ++__class)
+    {
+        __depot[__class] = FWL_pool_depot[__class];
+        FWL_pool_depot[__class] = NULL;
+    }
+    FWL_pool_depot_nodes = 0;
+    pthread_mutex_unlock(&FWL_pool_lock);
+
+    for (size_t __class = 0; __class < FWL_POOL_CLASSES; ++__class)
+    {
+        while(__depot[__class])
         {
-            __i->next = __i->next->next;
+            Forward_List_Node* __node = __depot[__class];
+            __depot[__class] = FWL_MAGAZINE_LINK(__node);
+            while(__node)
+            {
+                Forward_List_Node* __next = __node->next;
+                free(__node);
+                __node = __next;
+            }
+        }
+        Forward_List_Node* __node = __cache->head[__class];
+        while(__node)
+        {
+            Forward_List_Node* __next = __node->next;
+            free(__node);
+            __node = __next;
         }
+        __cache->head[__class] = NULL;
+        __cache->length[__class] = 0;
     }
-    --__src_list->count;
-    return __node;
 }
 
-static void FWL_splice_node(Forward_List* __list, FWL_iterator __position, Forward_List_Node* __node)
+static void FWL_exit_intrusive(const char* __func_name)
 {
-    if(!__node)
+    printf("%s : intrusive lists do not allocate\n", __func_name);
+    exit(EXIT_FAILURE);
+}
+
+static Forward_List_Node* FWL_get_node(Forward_List* __list)
+{
+    Forward_List_Node* __node = NULL;
+    if(__list->allocator == FWL_ALLOC_ARENA)
     {
-        return;
+        __node = FWL_arena_get_node(__list);
     }
-    if(__list->start == NULL)
+    else if(__list->allocator == FWL_ALLOC_POOL)
     {
-        FWL_init_list(__list, __node);
+        __node = FWL_pool_get_node(__list->size);
     }
-    else if(__position == FWL_before_begin(__list))
+    else if(__list->allocator == FWL_ALLOC_NONE)
     {
-        FWL_insert_before_begin(__list, __node);
+        FWL_exit_intrusive("FWL_get_node()");
     }
     else
     {
-	__FWL_insert_after(__list, __position, __node);
+        __node = (Forward_List_Node*) calloc(1, sizeof(Forward_List_Node*) + __list->size);
     }
-    ++__list->count;
+    if(!__node)
+    {
+        FWL_clear(__list);
+        FWL_exit("FWL_get_node()");
+    }
+    return __node;
 }
 
-void FWL_splice_after_element(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __i)
+static void FWL_put_node(Forward_List* __list, Forward_List_Node* __node)
 {
-    if(!__position || !__i)
+    if(__list->allocator == FWL_ALLOC_ARENA)
     {
-        return;
+        __node->next = __list->arena.free_nodes;
+        __list->arena.free_nodes = __node;
+    }
+    else if(__list->allocator == FWL_ALLOC_POOL)
+    {
+        FWL_pool_put_node(__list->size, __node);
+    }
+    else if(__list->allocator == FWL_ALLOC_HEAP)
+    {
+        free(__node);
     }
-    FWL_splice_node(__list, __position, FWL_unlink_node(__src_list, __i));
 }
 
-void FWL_splice_after_range(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __before, 
-                                                                                                     FWL_iterator __last)
+/*
+ * Allocates a chain of __n > 0 nodes whose storage is left uninitialized,
+ * and stores its last node in __last. Arena nodes are carved from one
+ * contiguous slab. Heap nodes still need one malloc() each, since each
+ * of them is freed on its own later.
+ */
+static Forward_List_Node* FWL_get_nodes(Forward_List* __list, size_t __n, Forward_List_Node** __last)
 {
-    if(FWL_empty(__src_list) || !__before || __before == __last || __before->next == __last)
-    {
-        return;
-    }
-    Forward_List_Node* __start = __before->next;
-    Forward_List_Node* __end = __last;
-    Forward_List_Node* __it = __before->next;
-    __before->next = __last;
-    if(__before->next == NULL)
+    Forward_List_Node __head = {.next = NULL};
+    Forward_List_Node* __tail = &__head;
+    if(__list->allocator == FWL_ALLOC_ARENA)
     {
-        if(__before == FWL_before_begin(__src_list))
+        Forward_List_Arena* __arena = &__list->arena;
+        size_t __node_size = FWL_node_size(__list->size);
+        if((size_t) (__arena->bump_end - __arena->bump) < __n * __node_size && !FWL_arena_grow(__list, __n))
         {
-            __src_list->finish = __before->next;
-            __src_list->start = __before->next;
+            FWL_clear(__list);
+            FWL_exit("FWL_get_nodes()");
         }
-        else
+        for (size_t __i = 0; __i < __n; ++__i, __arena->bump += __node_size)
         {
-            __src_list->finish = __before;
+            __tail->next = (Forward_List_Node*) __arena->bump;
+            __tail = __tail->next;
         }
     }
-    size_t __i = 0;
-    while(__it->next != __end)
+    else if(__list->allocator == FWL_ALLOC_POOL)
     {
-        __it = __it->next;
-        ++__i;
+        for (size_t __i = 0; __i < __n; ++__i)
+        {
+            __tail->next = FWL_get_node(__list);
+            __tail = __tail->next;
+        }
     }
-    __it->next = NULL;
-    __src_list->count -= __i+1;
-    Forward_List __temp_list = {
-                                  .start = __start,
-                                  .finish = __it,
-                                  .count = 1+__i,
-                                  .size = __src_list->size
-                               };
-    FWL_splice_after_list(__list, __position, &__temp_list);
+    else
+    {
+        if(__list->allocator == FWL_ALLOC_NONE)
+        {
+            FWL_exit_intrusive("FWL_get_nodes()");
+        }
+        for (size_t __i = 0; __i < __n; ++__i)
+        {
+            __tail->next = (Forward_List_Node*) malloc(sizeof(Forward_List_Node*) + __list->size);
+            if(!__tail->next)
+            {
+                Forward_List __chain = *__list;
+                __chain.start = __head.next;
+                memset(&__chain.index, 0, sizeof(__chain.index));
+                memset(&__chain.skip, 0, sizeof(__chain.skip));
+                FWL_clear(&__chain);
+                FWL_clear(__list);
+                FWL_exit("FWL_get_nodes()");
+            }
+            __tail = __tail->next;
+        }
+    }
+    __tail->next = NULL;
+    *__last = __tail;
+    return __head.next;
 }
 
-FWL_iterator FWL_erase_after(Forward_List* __list, FWL_iterator __before, FWL_iterator __last)
+/*
+ * Releases the unlinked chain starting at __first, up to but excluding
+ * __stop and at most *__n nodes. Stores the number of nodes released in
+ * *__n and returns the node the walk stopped at. Heap nodes are freed as
+ * the chain is walked, arena and pool nodes are handed back in one step.
+ */
+static FWL_iterator FWL_put_chain(Forward_List* __list, Forward_List_Node* __first, FWL_iterator __stop, size_t* __n)
 {
-    if(__before == __last)
+    size_t __limit = *__n;
+    size_t __count = 0;
+    Forward_List_Node* __it = __first;
+    Forward_List_Node* __tail = NULL;
+    if(__list->allocator == FWL_ALLOC_HEAP)
     {
-        return __before;
-    }
-    if(FWL_empty(__list))
-    {
-        return NULL;
-    }
-    FWL_iterator __it = __before;
-    if(__it == FWL_before_begin(__list))
-    {
-        while (__list->start != __last)
+        for (Forward_List_Node* __next = NULL; __it != __stop && __count < __limit; __it = __next, ++__count)
         {
-            FWL_pop_after(__list, __it);
+            __next = __it->next;
+            free(__it);
         }
     }
     else
     {
-        while (__it->next != __last)
+        for (; __it != __stop && __count < __limit; __tail = __it, __it = __it->next)
+        {
+            ++__count;
+        }
+        if(__count && __list->allocator == FWL_ALLOC_ARENA)
+        {
+            __tail->next = __list->arena.free_nodes;
+            __list->arena.free_nodes = __first;
+        }
+        else if(__count && __list->allocator == FWL_ALLOC_POOL)
         {
-            FWL_pop_after(__list, __it);
+            FWL_pool_put_chain(__list->size, __first, __tail, __count);
         }
     }
-    return __last;
+    *__n = __count;
+    return __it;
 }
 
-int FWL_empty(Forward_List* __list)
+/* Nodes can only move between lists that release them the same way. */
+static void FWL_check_splice(Forward_List* __list, Forward_List* __src_list, const char* __func_name)
 {
-    if(__list->start == NULL)
+    if(__list == __src_list)
+    {
+        return;
+    }
+    if(__list->allocator != __src_list->allocator || __list->allocator == FWL_ALLOC_ARENA ||
+       __list->offset != __src_list->offset)
+    {
+        printf("%s : incompatible node allocators\n", __func_name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/*
+ * The index is only a shortcut. Operations that reshape the list mark it
+ * stale through FWL_invalidate() and it is rebuilt when next needed, or
+ * given up for a linear walk if it cannot be allocated.
+ */
+static void FWL_invalidate(Forward_List* __list)
+{
+    __list->index.valid = 0;
+    __list->skip.valid = 0;
+}
+
+static int FWL_index_reserve(Forward_List_Index* __index, size_t __n)
+{
+    if(__n <= __index->capacity)
     {
         return 1;
     }
-    else
+    size_t __capacity = __index->capacity ? 2 * __index->capacity : 16;
+    while(__capacity < __n)
+    {
+        __capacity *= 2;
+    }
+    Forward_List_Node** __nodes = (Forward_List_Node**) realloc(__index->nodes, __capacity * sizeof(Forward_List_Node*));
+    if(!__nodes)
     {
         return 0;
     }
+    __index->nodes = __nodes;
+    __index->capacity = __capacity;
+    return 1;
 }
 
-size_t FWL_size(Forward_List* __list)
+static void FWL_index_release(Forward_List_Index* __index)
 {
-    return __list->count;
+    free(__index->nodes);
+    __index->nodes = NULL;
+    __index->length = 0;
+    __index->capacity = 0;
+    __index->valid = 0;
 }
 
-void FWL_sort(Forward_List* __list, int (*__compare)(const void *, const void *))
+/* Called once __node has been linked and counted as the last element. */
+static void FWL_index_append(Forward_List* __list, Forward_List_Node* __node)
 {
-    if (!__list->start || !__list->start->next || !__compare)
+    Forward_List_Index* __index = &__list->index;
+    if(!__index->valid || (__list->count - 1) % __index->stride != 0)
     {
         return;
     }
+    if(!FWL_index_reserve(__index, __index->length + 1))
+    {
+        __index->valid = 0;
+        return;
+    }
+    __index->nodes[__index->length++] = __node;
+}
 
-    Forward_List_Node** head = &__list->start;
-    Forward_List_Node* start1 = NULL;
-    Forward_List_Node* end1 = NULL;
-    Forward_List_Node* start2 = NULL;
-    Forward_List_Node* end2 = NULL; 
-    Forward_List_Node* prevend = NULL;
-    Forward_List_Node* temp = NULL;
-
-    Forward_List_Node* __temp = NULL;
-    Forward_List_Node* astart = NULL;
-    Forward_List_Node* aend = NULL;
-    Forward_List_Node* bstart = NULL;
-    Forward_List_Node* bendnext = NULL;
-
-    size_t counter = 0;
-    int isFirstIter = 0;
-
-    for (size_t gap = 1; gap < __list->count; gap = gap * 2) 
+/* Rebuilds a stale index, returns false if it is not usable. */
+static int FWL_index_ready(Forward_List* __list)
+{
+    Forward_List_Index* __index = &__list->index;
+    if(__index->valid)
     {
-        start1 = *head;
-        for (; start1;) 
+        return 1;
+    }
+    if(!FWL_index_reserve(__index, (__list->count + __index->stride - 1) / __index->stride))
+    {
+        return 0;
+    }
+    __index->length = 0;
+    size_t __i = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__i)
+    {
+        if(__i % __index->stride == 0)
+        {
+            __index->nodes[__index->length++] = __it;
+        }
+    }
+    __index->valid = 1;
+    return 1;
+}
+
+void FWL_enable_index(Forward_List* __list, size_t __stride)
+{
+    if(__stride != __list->index.stride)
+    {
+        FWL_index_release(&__list->index);
+    }
+    __list->index.stride = __stride;
+    __list->index.valid = 0;
+}
+
+void FWL_enable_pop_back_index(Forward_List* __list, int __enable)
+{
+    FWL_enable_index(__list, __enable ? 1 : 0);
+}
+
+size_t FWL_index_memory(Forward_List* __list)
+{
+    return __list->index.capacity * sizeof(Forward_List_Node*);
+}
+
+FWL_iterator FWL_at(Forward_List* __list, size_t __i)
+{
+    if(__i >= __list->count)
+    {
+        return NULL;
+    }
+    if(__list->index.stride && FWL_index_ready(__list))
+    {
+        return FWL_advance(__list->index.nodes[__i / __list->index.stride], __i % __list->index.stride);
+    }
+    return FWL_advance(FWL_begin(__list), __i);
+}
+
+FWL_iterator FWL_advance_in(Forward_List* __list, FWL_iterator __current, size_t __n)
+{
+    if(__current == FWL_before_begin(__list) && __n)
+    {
+        return FWL_at(__list, __n - 1);
+    }
+    if(__current && __current == FWL_begin(__list))
+    {
+        return FWL_at(__list, __n);
+    }
+    return FWL_advance(__current, __n);
+}
+
+static void FWL_init_list(Forward_List* __list, Forward_List_Node* __node)
+{
+    __node->next = NULL;
+    __list->start = __node;
+    __list->finish = __node;
+}
+
+static void FWL_insert_before_begin(Forward_List* __list, Forward_List_Node* __node)
+{
+    __node->next = __list->start;
+    __list->start = __node;
+}
+
+static void __FWL_insert_after(Forward_List* __list, FWL_iterator __position, Forward_List_Node* __node)
+{
+    __node->next = __position->next;
+    if(__node->next == NULL)
+    {
+        __list->finish = __node;
+    }
+    __position->next = __node;
+}
+
+/* Links a node after position and counts it. */
+static void FWL_link_node(Forward_List* __list, FWL_iterator __position, Forward_List_Node* __node)
+{
+    if(__list->start == NULL)
+    {
+        FWL_init_list(__list, __node);
+    }
+    else
+    {
+        if(__position == FWL_before_begin(__list))
+        {
+            FWL_insert_before_begin(__list, __node);
+        }
+        else
+        {
+            __FWL_insert_after(__list, __position, __node);
+        }
+    }
+    ++__list->count;
+    /* A node without a tower leaves the skip list usable. */
+    if(__list->finish == __node)
+    {
+        FWL_index_append(__list, __node);
+    }
+    else
+    {
+        __list->index.valid = 0;
+    }
+}
+
+FWL_iterator _FWL_insert_after(Forward_List* __list, FWL_iterator __position, void** __storage)
+{
+    Forward_List_Node* __node = FWL_get_node(__list);
+    FWL_link_node(__list, __position, __node);
+    *__storage = __node->storage;
+    return __node;
+}
+
+FWL_iterator FWL_link_after(Forward_List* __list, FWL_iterator __position, Forward_List_Link* __link)
+{
+    Forward_List_Node* __node = (Forward_List_Node*) __link;
+    FWL_link_node(__list, __position, __node);
+    return __node;
+}
+
+static void FWL_reset(Forward_List* __list)
+{
+    __list->start = NULL;
+    __list->finish = NULL;
+    __list->count = 0;
+    __list->index.length = 0;
+    FWL_invalidate(__list);
+}
+
+static void __FWL_splice_after_list(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list)
+{
+    FWL_invalidate(__list);
+    if(FWL_empty(__list))
+    {
+        __list->start = __src_list->start;
+        __list->finish = __src_list->finish;
+    }
+    else if(__position == FWL_before_begin(__list))
+    {
+        __src_list->finish->next = __list->start;
+        __list->start = __src_list->start;
+    }
+    else if(__position == FWL_rbegin(__list))
+    {
+        __list->finish->next = __src_list->start;
+        __list->finish = __src_list->finish;
+    }
+    else
+    {
+        __src_list->finish->next = __position->next;
+        __position->next = __src_list->start;
+    }
+
+    __list->count += __src_list->count;
+
+    FWL_reset(__src_list);
+}
+
+void FWL_splice_after_list(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list)
+{
+    if(__position == NULL || FWL_empty(__src_list))
+    {
+        return;
+    }
+    FWL_check_splice(__list, __src_list, "FWL_splice_after_list()");
+    __FWL_splice_after_list(__list, __position, __src_list);
+}
+
+static Forward_List_Node* FWL_unlink_node(Forward_List* __src_list, FWL_iterator __i)
+{
+    Forward_List_Node* __node = NULL;
+    if(__i->next)
+    {
+        __node = __i->next;
+    }
+    else
+    {
+        return NULL;
+    }
+    if(__i == FWL_before_begin(__src_list))
+    {
+        __src_list->start = __src_list->start->next;
+        if(__src_list->start == FWL_end(__src_list))
+        {
+            __src_list->finish = __src_list->start;
+        }
+    }
+    else if(__i->next == FWL_rbegin(__src_list))
+    {
+        __src_list->finish = __i;
+        __src_list->finish->next = NULL;
+    }
+    else
+    {
+        if(__i->next)
+        {
+            __i->next = __i->next->next;
+        }
+    }
+    --__src_list->count;
+    FWL_invalidate(__src_list);
+    return __node;
+}
+
+static void FWL_splice_node(Forward_List* __list, FWL_iterator __position, Forward_List_Node* __node)
+{
+    if(!__node)
+    {
+        return;
+    }
+    if(__list->start == NULL)
+    {
+        FWL_init_list(__list, __node);
+    }
+    else if(__position == FWL_before_begin(__list))
+    {
+        FWL_insert_before_begin(__list, __node);
+    }
+    else
+    {
+	__FWL_insert_after(__list, __position, __node);
+    }
+    ++__list->count;
+    FWL_invalidate(__list);
+}
+
+void FWL_splice_after_element(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __i)
+{
+    if(!__position || !__i)
+    {
+        return;
+    }
+    FWL_check_splice(__list, __src_list, "FWL_splice_after_element()");
+    FWL_splice_node(__list, __position, FWL_unlink_node(__src_list, __i));
+}
+
+void FWL_splice_after_range(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __before, 
+                                                                                                     FWL_iterator __last)
+{
+    if(FWL_empty(__src_list) || !__before || __before == __last || __before->next == __last)
+    {
+        return;
+    }
+    FWL_check_splice(__list, __src_list, "FWL_splice_after_range()");
+    Forward_List_Node* __start = __before->next;
+    Forward_List_Node* __end = __last;
+    Forward_List_Node* __it = __before->next;
+    __before->next = __last;
+    if(__before->next == NULL)
+    {
+        if(__before == FWL_before_begin(__src_list))
+        {
+            __src_list->finish = __before->next;
+            __src_list->start = __before->next;
+        }
+        else
+        {
+            __src_list->finish = __before;
+        }
+    }
+    size_t __i = 0;
+    while(__it->next != __end)
+    {
+        __it = __it->next;
+        ++__i;
+    }
+    __it->next = NULL;
+    __src_list->count -= __i+1;
+    FWL_invalidate(__src_list);
+    Forward_List __temp_list = {
+                                  .start = __start,
+                                  .finish = __it,
+                                  .count = 1+__i,
+                                  .size = __src_list->size
+                               };
+    __FWL_splice_after_list(__list, __position, &__temp_list);
+}
+
+void FWL_splice_after_range_n(Forward_List* __list, FWL_iterator __position, Forward_List* __src_list, FWL_iterator __before,
+                                                                      FWL_iterator __last_node, size_t __n)
+{
+    if(!__position || !__before || !__last_node || !__n || __before == __last_node)
+    {
+        return;
+    }
+    FWL_check_splice(__list, __src_list, "FWL_splice_after_range_n()");
+    Forward_List_Node* __first = __before->next;
+    __before->next = __last_node->next;
+    if(__src_list->finish == __last_node)
+    {
+        __src_list->finish = __before == FWL_before_begin(__src_list) ? NULL : __before;
+    }
+    __src_list->count -= __n;
+    __last_node->next = NULL;
+    FWL_invalidate(__src_list);
+    Forward_List __temp_list = {
+                                  .start = __first,
+                                  .finish = __last_node,
+                                  .count = __n,
+                                  .size = __src_list->size
+                               };
+    __FWL_splice_after_list(__list, __position, &__temp_list);
+}
+
+/* Position after which elements are appended to a %forward_list. */
+static FWL_iterator FWL_append_position(Forward_List* __list)
+{
+    return FWL_empty(__list) ? FWL_before_begin(__list) : FWL_rbegin(__list);
+}
+
+void FWL_split_after(Forward_List* __list, FWL_iterator __position, size_t __index, Forward_List* __out)
+{
+    if(!__position || __index >= __list->count)
+    {
+        return;
+    }
+    FWL_splice_after_range_n(__out, FWL_append_position(__out), __list, __position, __list->finish,
+                                                                                    __list->count - __index);
+}
+
+void FWL_split_prefix(Forward_List* __list, FWL_iterator __last_node, size_t __n, Forward_List* __out)
+{
+    FWL_splice_after_range_n(__out, FWL_append_position(__out), __list, FWL_before_begin(__list), __last_node, __n);
+}
+
+FWL_iterator FWL_erase_after(Forward_List* __list, FWL_iterator __before, FWL_iterator __last)
+{
+    if(__before == __last)
+    {
+        return __before;
+    }
+    if(FWL_empty(__list))
+    {
+        return NULL;
+    }
+    Forward_List_Node* __first = __before->next;
+    if(__first == __last)
+    {
+        return __last;
+    }
+    /* Unlink the whole range at once, then release it in one walk. */
+    __before->next = __last;
+    if(__last == NULL)
+    {
+        __list->finish = __before == FWL_before_begin(__list) ? NULL : __before;
+    }
+    size_t __n = (size_t) -1;
+    FWL_put_chain(__list, __first, __last, &__n);
+    __list->count -= __n;
+    FWL_invalidate(__list);
+    return __last;
+}
+
+size_t FWL_pop_front_n(Forward_List* __list, size_t __n)
+{
+    if(__n >= __list->count)
+    {
+        __n = __list->count;
+        FWL_clear(__list);
+        return __n;
+    }
+    if(__n)
+    {
+        __list->start = FWL_put_chain(__list, __list->start, NULL, &__n);
+        __list->count -= __n;
+        FWL_invalidate(__list);
+    }
+    return __n;
+}
+
+int FWL_empty(Forward_List* __list)
+{
+    if(__list->start == NULL)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+size_t FWL_size(Forward_List* __list)
+{
+    return __list->count;
+}
+
+/*
+ * Adaptive natural merge sort.
+ *
+ * The list is cut into maximal runs that are already ascending, or
+ * strictly descending and reversed on the spot so that stability is
+ * kept. Runs are pushed on a stack and merged following the TimSort
+ * invariants, which keeps the stack logarithmic and merges runs of
+ * similar lengths. Merging two runs whose boundaries are already in
+ * order is a constant time concatenation, so sorted input costs a
+ * single pass of n - 1 comparisons.
+ */
+struct FWL_Sort_Order
+{
+    Forward_List* list;
+    int (*greater)(const void *, const void *);
+    int (*compare)(const void *, const void *);
+};
+
+struct FWL_Sort_Run
+{
+    Forward_List_Node* head;
+    Forward_List_Node* tail;
+    size_t length;
+};
+
+/* Returns true if the element of __a must be placed after the element of __b. */
+static int FWL_sort_greater(const struct FWL_Sort_Order* __order, Forward_List_Node* __a, Forward_List_Node* __b)
+{
+    const void* __x = FWL_value(__order->list, __a);
+    const void* __y = FWL_value(__order->list, __b);
+    if(__order->compare)
+    {
+        return __order->compare(__x, __y) > 0;
+    }
+    return __order->greater(__x, __y) != 0;
+}
+
+/* Cuts the next run off the chain starting at __it and returns what follows it. */
+static Forward_List_Node* FWL_sort_next_run(const struct FWL_Sort_Order* __order, Forward_List_Node* __it, struct FWL_Sort_Run* __run)
+{
+    Forward_List_Node* __next = __it->next;
+    __run->head = __it;
+    __run->tail = __it;
+    __run->length = 1;
+    if(__next && FWL_sort_greater(__order, __it, __next))
+    {
+        /* Strictly descending, reversed while it is scanned. */
+        __it->next = NULL;
+        do
+        {
+            Forward_List_Node* __node = __next;
+            __next = __node->next;
+            __node->next = __run->head;
+            __run->head = __node;
+            ++__run->length;
+        } while(__next && FWL_sort_greater(__order, __run->head, __next));
+        return __next;
+    }
+    while(__next && !FWL_sort_greater(__order, __run->tail, __next))
+    {
+        __run->tail = __next;
+        __next = __next->next;
+        ++__run->length;
+    }
+    __run->tail->next = NULL;
+    return __next;
+}
+
+/* Stable merge of two adjacent runs, __left preceding __right in list order. */
+static void FWL_sort_merge(const struct FWL_Sort_Order* __order, struct FWL_Sort_Run* __left, const struct FWL_Sort_Run* __right)
+{
+    __left->length += __right->length;
+    if(!FWL_sort_greater(__order, __left->tail, __right->head))
+    {
+        __left->tail->next = __right->head;
+        __left->tail = __right->tail;
+        return;
+    }
+    Forward_List_Node __head = {.next = NULL};
+    Forward_List_Node* __tail = &__head;
+    Forward_List_Node* __a = __left->head;
+    Forward_List_Node* __b = __right->head;
+    while(__a && __b)
+    {
+        if(FWL_sort_greater(__order, __a, __b))
+        {
+            __tail->next = __b;
+            __b = __b->next;
+        }
+        else
+        {
+            __tail->next = __a;
+            __a = __a->next;
+        }
+        __tail = __tail->next;
+    }
+    if(__a)
+    {
+        __tail->next = __a;
+    }
+    else
+    {
+        __tail->next = __b;
+        __left->tail = __right->tail;
+    }
+    __left->head = __head.next;
+}
+
+/* Merges runs __i and __i+1 of the stack. */
+static void FWL_sort_merge_at(const struct FWL_Sort_Order* __order, struct FWL_Sort_Run* __stack, size_t* __depth, size_t __i)
+{
+    FWL_sort_merge(__order, &__stack[__i], &__stack[__i + 1]);
+    for (size_t __j = __i + 1; __j + 1 < *__depth; ++__j)
+    {
+        __stack[__j] = __stack[__j + 1];
+    }
+    --*__depth;
+}
+
+static void FWL_sort_collapse(const struct FWL_Sort_Order* __order, struct FWL_Sort_Run* __stack, size_t* __depth)
+{
+    while(*__depth > 1)
+    {
+        size_t __n = *__depth - 2;
+        if((__n > 0 && __stack[__n - 1].length <= __stack[__n].length + __stack[__n + 1].length) ||
+           (__n > 1 && __stack[__n - 2].length <= __stack[__n - 1].length + __stack[__n].length))
+        {
+            if(__stack[__n - 1].length < __stack[__n + 1].length)
+            {
+                --__n;
+            }
+        }
+        else if(__stack[__n].length > __stack[__n + 1].length)
+        {
+            break;
+        }
+        FWL_sort_merge_at(__order, __stack, __depth, __n);
+    }
+}
+
+static void FWL_sort_runs(Forward_List* __list, const struct FWL_Sort_Order* __order)
+{
+    if(!__list->start || !__list->start->next)
+    {
+        return;
+    }
+    /* The invariants bound the depth by log base phi of the length. */
+    struct FWL_Sort_Run __stack[128];
+    size_t __depth = 0;
+    Forward_List_Node* __it = __list->start;
+    while(__it)
+    {
+        __it = FWL_sort_next_run(__order, __it, &__stack[__depth++]);
+        FWL_sort_collapse(__order, __stack, &__depth);
+    }
+    while(__depth > 1)
+    {
+        FWL_sort_merge_at(__order, __stack, &__depth, __depth - 2);
+    }
+    __list->start = __stack[0].head;
+    __list->finish = __stack[0].tail;
+}
+
+/*
+ * Sorting through an array of node pointers.
+ *
+ * Once a list outgrows the caches every hop of a linked merge is a
+ * likely miss. Long lists are therefore gathered into an array of node
+ * pointers in one sequential pass, the array is sorted with a stable
+ * bottom-up merge sort, and the list is relinked in a second pass. Each
+ * entry can carry an order preserving 8 byte prefix of its key, which
+ * settles most comparisons without touching the element.
+ */
+struct FWL_Sort_Entry
+{
+    uint64_t prefix;
+    Forward_List_Node* node;
+};
+
+static int FWL_entry_greater(const struct FWL_Sort_Order* __order, int __prefixed,
+                             const struct FWL_Sort_Entry* __a, const struct FWL_Sort_Entry* __b)
+{
+    if(__prefixed && __a->prefix != __b->prefix)
+    {
+        return __a->prefix > __b->prefix;
+    }
+    return FWL_sort_greater(__order, __a->node, __b->node);
+}
+
+static void FWL_sort_entries(const struct FWL_Sort_Order* __order, int __prefixed,
+                             struct FWL_Sort_Entry* __a, struct FWL_Sort_Entry* __buffer, size_t __n)
+{
+    for (size_t __lo = 0; __lo < __n; __lo += FWL_SORT_ARRAY_BLOCK)
+    {
+        size_t __hi = __lo + FWL_SORT_ARRAY_BLOCK < __n ? __lo + FWL_SORT_ARRAY_BLOCK : __n;
+        for (size_t __i = __lo + 1; __i < __hi; ++__i)
+        {
+            struct FWL_Sort_Entry __e = __a[__i];
+            size_t __j = __i;
+            for (; __j > __lo && FWL_entry_greater(__order, __prefixed, &__a[__j - 1], &__e); --__j)
+            {
+                __a[__j] = __a[__j - 1];
+            }
+            __a[__j] = __e;
+        }
+    }
+    struct FWL_Sort_Entry* __src = __a;
+    struct FWL_Sort_Entry* __dst = __buffer;
+    for (size_t __width = FWL_SORT_ARRAY_BLOCK; __width < __n; __width *= 2)
+    {
+        for (size_t __lo = 0; __lo < __n; __lo += 2 * __width)
+        {
+            size_t __mid = __lo + __width < __n ? __lo + __width : __n;
+            size_t __hi = __lo + 2 * __width < __n ? __lo + 2 * __width : __n;
+            size_t __i = __lo, __j = __mid, __k = __lo;
+            if(__mid < __hi && FWL_entry_greater(__order, __prefixed, &__src[__mid - 1], &__src[__mid]))
+            {
+                while(__i < __mid && __j < __hi)
+                {
+                    if(FWL_entry_greater(__order, __prefixed, &__src[__i], &__src[__j]))
+                    {
+                        __dst[__k++] = __src[__j++];
+                    }
+                    else
+                    {
+                        __dst[__k++] = __src[__i++];
+                    }
+                }
+            }
+            memcpy(&__dst[__k], &__src[__i], (__mid - __i) * sizeof(*__src));
+            __k += __mid - __i;
+            memcpy(&__dst[__k], &__src[__j], (__hi - __j) * sizeof(*__src));
+        }
+        struct FWL_Sort_Entry* __temp = __src;
+        __src = __dst;
+        __dst = __temp;
+    }
+    if(__src != __a)
+    {
+        memcpy(__a, __src, __n * sizeof(*__a));
+    }
+}
+
+/* Returns 0 without touching the list if the arrays can not be allocated. */
+static int FWL_sort_array(Forward_List* __list, const struct FWL_Sort_Order* __order, uint64_t (*__prefix)(const void *))
+{
+    size_t __n = __list->count;
+    struct FWL_Sort_Entry* __entries = (struct FWL_Sort_Entry*) malloc(2 * __n * sizeof(struct FWL_Sort_Entry));
+    if(!__entries)
+    {
+        return 0;
+    }
+    size_t __i = 0;
+    for (FWL_iterator __it = __list->start; __it; __it = __it->next, ++__i)
+    {
+        __entries[__i].node = __it;
+        __entries[__i].prefix = __prefix ? __prefix(FWL_value(__list, __it)) : 0;
+    }
+    FWL_sort_entries(__order, __prefix != NULL, __entries, __entries + __n, __n);
+    Forward_List_Node* __tail = (Forward_List_Node*) &__list->start;
+    for (__i = 0; __i < __n; ++__i)
+    {
+        __tail->next = __entries[__i].node;
+        __tail = __tail->next;
+    }
+    __tail->next = NULL;
+    __list->finish = __tail;
+    free(__entries);
+    return 1;
+}
+
+static void FWL_sort_list(Forward_List* __list, const struct FWL_Sort_Order* __order, uint64_t (*__prefix)(const void *))
+{
+    FWL_invalidate(__list);
+    if(__list->count >= FWL_SORT_ARRAY_MIN && FWL_sort_array(__list, __order, __prefix))
+    {
+        return;
+    }
+    FWL_sort_runs(__list, __order);
+}
+
+void FWL_sort(Forward_List* __list, int (*__compare)(const void *, const void *))
+{
+    if(!__compare)
+    {
+        return;
+    }
+    struct FWL_Sort_Order __order = {.list = __list, .greater = __compare, .compare = NULL};
+    FWL_sort_list(__list, &__order, NULL);
+}
+
+void FWL_sort3(Forward_List* __list, int (*__compare)(const void *, const void *))
+{
+    if(!__compare)
+    {
+        return;
+    }
+    struct FWL_Sort_Order __order = {.list = __list, .greater = NULL, .compare = __compare};
+    FWL_sort_list(__list, &__order, NULL);
+}
+
+void FWL_sort_prefixed(Forward_List* __list, int (*__compare)(const void *, const void *), uint64_t (*__prefix)(const void *))
+{
+    if(!__compare)
+    {
+        return;
+    }
+    FWL_invalidate(__list);
+    struct FWL_Sort_Order __order = {.list = __list, .greater = __compare, .compare = NULL};
+    if(__list->count < 2 || !__prefix || !FWL_sort_array(__list, &__order, __prefix))
+    {
+        FWL_sort_runs(__list, &__order);
+    }
+}
+
+uint64_t FWL_string_prefix(const void* __value)
+{
+    const unsigned char* __string = *(const unsigned char* const*) __value;
+    uint64_t __prefix = 0;
+    size_t __i = 0;
+    for (; __i < sizeof(__prefix) && __string[__i]; ++__i)
+    {
+        __prefix = (__prefix << 8) | __string[__i];
+    }
+    return __prefix << (8 * (sizeof(__prefix) - __i));
+}
+
+/*
+ * Fork-join worker threads.
+ *
+ * A batch of independent tasks is published to lazily started workers
+ * and the calling thread takes part in running it. The tasks are dealt
+ * out as one contiguous range per thread. A thread runs its own range
+ * from the front and, once it is done, steals from the back of the
+ * others, so threads given slower tasks get help. The caller returns
+ * once every task of the batch has finished.
+ * Batches are serialized. A task cannot wait for a batch of its own,
+ * so the threads running tasks are flagged and the parallel walks they
+ * start run sequentially instead.
+ */
+struct FWL_Task
+{
+    void (*run)(void *);
+    void* arg;
+};
+
+static struct
+{
+    pthread_mutex_t batch;      /* Held by the thread running a batch. */
+    pthread_mutex_t lock;       /* Protects the fields below. */
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    size_t nthreads;
+    unsigned long generation;
+    struct FWL_Task* tasks;
+    size_t ntasks;
+    size_t nslots;
+    size_t joined;              /* Threads that took a slot in the batch. */
+    size_t finished;
+    size_t active;              /* Workers inside the current batch. */
+    struct
+    {
+        uint64_t span;          /* Unclaimed tasks, first in the low half, end in the high one. */
+    } __attribute__((aligned(64))) slots[FWL_WORKERS_MAX_SLOTS];
+} FWL_workers = {.batch = PTHREAD_MUTEX_INITIALIZER, .lock = PTHREAD_MUTEX_INITIALIZER,
+                 .wake = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER};
+
+/* Set on the workers and on a caller while it runs tasks of its batch. */
+static _Thread_local int FWL_workers_inside;
+
+/* Claims the first task of a slot, or the last one when stealing. */
+static int FWL_workers_claim(size_t __slot, int __steal, size_t* __i)
+{
+    uint64_t* __span = &FWL_workers.slots[__slot].span;
+    uint64_t __old = __atomic_load_n(__span, __ATOMIC_RELAXED);
+    for (;;)
+    {
+        uint64_t __begin = __old & 0xffffffff;
+        uint64_t __end = __old >> 32;
+        if(__begin >= __end)
+        {
+            return 0;
+        }
+        uint64_t __new = __steal ? (__begin | (__end - 1) << 32) : ((__begin + 1) | __end << 32);
+        if(__atomic_compare_exchange_n(__span, &__old, __new, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+        {
+            *__i = __steal ? __end - 1 : __begin;
+            return 1;
+        }
+    }
+}
+
+/* Runs tasks of the current batch until none is left to claim. */
+static void FWL_workers_drain(struct FWL_Task* __tasks, size_t __ntasks, size_t __nslots, int __worker)
+{
+    size_t __ran = 0;
+    size_t __slot = __atomic_fetch_add(&FWL_workers.joined, 1, __ATOMIC_RELAXED) % __nslots;
+    for (;;)
+    {
+        size_t __i = 0;
+        size_t __victim = 0;
+        while(__victim < __nslots && !FWL_workers_claim((__slot + __victim) % __nslots, __victim != 0, &__i))
+        {
+            ++__victim;
+        }
+        if(__victim == __nslots)
+        {
+            break;
+        }
+        __tasks[__i].run(__tasks[__i].arg);
+        ++__ran;
+    }
+    pthread_mutex_lock(&FWL_workers.lock);
+    FWL_workers.finished += __ran;
+    FWL_workers.active -= __worker;
+    if(FWL_workers.finished == __ntasks && FWL_workers.active == 0)
+    {
+        pthread_cond_broadcast(&FWL_workers.done);
+    }
+    pthread_mutex_unlock(&FWL_workers.lock);
+}
+
+static void* FWL_workers_main(void* __arg)
+{
+    unsigned long __seen = 0;
+    (void) __arg;
+    FWL_workers_inside = 1;
+    for (;;)
+    {
+        pthread_mutex_lock(&FWL_workers.lock);
+        while(FWL_workers.generation == __seen)
+        {
+            pthread_cond_wait(&FWL_workers.wake, &FWL_workers.lock);
+        }
+        __seen = FWL_workers.generation;
+        struct FWL_Task* __tasks = FWL_workers.tasks;
+        size_t __ntasks = FWL_workers.ntasks;
+        size_t __nslots = FWL_workers.nslots;
+        ++FWL_workers.active;
+        pthread_mutex_unlock(&FWL_workers.lock);
+        FWL_workers_drain(__tasks, __ntasks, __nslots, 1);
+    }
+    return NULL;
+}
+
+/*
+ * The number of threads worth running on a list, at most
+ * FWL_WORKERS_MAX_SLOTS, and one within a task of the pool.
+ */
+static size_t FWL_workers_clamp(Forward_List* __list, size_t __nthreads)
+{
+    if(FWL_workers_inside)
+    {
+        return 1;
+    }
+    if(__nthreads > __list->count / FWL_PARALLEL_MIN_NODES)
+    {
+        __nthreads = __list->count / FWL_PARALLEL_MIN_NODES;
+    }
+    if(__nthreads > FWL_WORKERS_MAX_SLOTS)
+    {
+        __nthreads = FWL_WORKERS_MAX_SLOTS;
+    }
+    return __nthreads;
+}
+
+/*
+ * Runs __ntasks tasks on up to __nthreads threads, the caller included.
+ * Workers are started on demand and never exit, FWL_WORKERS_MAX_SLOTS - 1
+ * at most.
+ */
+static void FWL_workers_run(struct FWL_Task* __tasks, size_t __ntasks, size_t __nthreads)
+{
+    if(__ntasks == 0)
+    {
+        return;
+    }
+    if(__nthreads > FWL_WORKERS_MAX_SLOTS)
+    {
+        __nthreads = FWL_WORKERS_MAX_SLOTS;
+    }
+    pthread_mutex_lock(&FWL_workers.batch);
+    while(FWL_workers.nthreads + 1 < __nthreads)
+    {
+        pthread_t __worker;
+        if(pthread_create(&__worker, NULL, FWL_workers_main, NULL) != 0)
+        {
+            break;
+        }
+        pthread_detach(__worker);
+        ++FWL_workers.nthreads;
+    }
+    pthread_mutex_lock(&FWL_workers.lock);
+    /* A worker waking up late may still be looking at the previous batch. */
+    while(FWL_workers.active != 0)
+    {
+        pthread_cond_wait(&FWL_workers.done, &FWL_workers.lock);
+    }
+    size_t __nslots = __nthreads < __ntasks ? __nthreads : __ntasks;
+    if(__nslots == 0)
+    {
+        __nslots = 1;
+    }
+    for (size_t __s = 0; __s < __nslots; ++__s)
+    {
+        uint64_t __begin = __s * __ntasks / __nslots;
+        uint64_t __end = (__s + 1) * __ntasks / __nslots;
+        __atomic_store_n(&FWL_workers.slots[__s].span, __begin | __end << 32, __ATOMIC_RELAXED);
+    }
+    FWL_workers.tasks = __tasks;
+    FWL_workers.ntasks = __ntasks;
+    FWL_workers.nslots = __nslots;
+    FWL_workers.joined = 0;
+    FWL_workers.finished = 0;
+    ++FWL_workers.generation;
+    pthread_cond_broadcast(&FWL_workers.wake);
+    pthread_mutex_unlock(&FWL_workers.lock);
+
+    FWL_workers_inside = 1;
+    FWL_workers_drain(__tasks, __ntasks, __nslots, 0);
+    FWL_workers_inside = 0;
+
+    pthread_mutex_lock(&FWL_workers.lock);
+    while(FWL_workers.finished != __ntasks || FWL_workers.active != 0)
+    {
+        pthread_cond_wait(&FWL_workers.done, &FWL_workers.lock);
+    }
+    pthread_mutex_unlock(&FWL_workers.lock);
+    pthread_mutex_unlock(&FWL_workers.batch);
+}
+
+/*
+ * Cuts the list into __n chains of balanced lengths in one pass. Without
+ * __detach the chunks are only located and the list stays linked.
+ */
+static void FWL_split_chunks(Forward_List* __list, struct FWL_Sort_Run* __chunks, size_t __n, int __detach)
+{
+    Forward_List_Node* __it = __list->start;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        size_t __length = __list->count / __n + (__i < __list->count % __n);
+        __chunks[__i].head = __it;
+        __chunks[__i].length = __length;
+        for (size_t __k = 1; __k < __length; ++__k)
+        {
+            __it = __it->next;
+        }
+        __chunks[__i].tail = __it;
+        __it = __it->next;
+        if(__detach)
+        {
+            __chunks[__i].tail->next = NULL;
+        }
+    }
+}
+
+struct FWL_Sort_Job
+{
+    const struct FWL_Sort_Order* order;
+    struct FWL_Sort_Run* left;
+    struct FWL_Sort_Run* right;
+};
+
+static void FWL_sort_chunk(void* __arg)
+{
+    struct FWL_Sort_Job* __job = (struct FWL_Sort_Job*) __arg;
+    Forward_List __chunk = *__job->order->list;
+    __chunk.start = __job->left->head;
+    __chunk.finish = __job->left->tail;
+    __chunk.count = __job->left->length;
+    FWL_sort_runs(&__chunk, __job->order);
+    __job->left->head = __chunk.start;
+    __job->left->tail = __chunk.finish;
+}
+
+static void FWL_merge_chunks(void* __arg)
+{
+    struct FWL_Sort_Job* __job = (struct FWL_Sort_Job*) __arg;
+    FWL_sort_merge(__job->order, __job->left, __job->right);
+}
+
+void FWL_sort_parallel(Forward_List* __list, int (*__compare)(const void *, const void *), size_t __nthreads)
+{
+    if(!__compare)
+    {
+        return;
+    }
+    FWL_invalidate(__list);
+    __nthreads = FWL_workers_clamp(__list, __nthreads);
+    if(__nthreads < 2)
+    {
+        FWL_sort(__list, __compare);
+        return;
+    }
+    struct FWL_Sort_Order __order = {.list = __list, .greater = __compare, .compare = NULL};
+    struct FWL_Sort_Run* __chunks = (struct FWL_Sort_Run*) malloc(__nthreads * sizeof(struct FWL_Sort_Run));
+    struct FWL_Sort_Job* __jobs = (struct FWL_Sort_Job*) malloc(__nthreads * sizeof(struct FWL_Sort_Job));
+    struct FWL_Task* __tasks = (struct FWL_Task*) malloc(__nthreads * sizeof(struct FWL_Task));
+    if(!__chunks || !__jobs || !__tasks)
+    {
+        free(__chunks);
+        free(__jobs);
+        free(__tasks);
+        FWL_sort(__list, __compare);
+        return;
+    }
+    FWL_split_chunks(__list, __chunks, __nthreads, 1);
+    for (size_t __i = 0; __i < __nthreads; ++__i)
+    {
+        __jobs[__i] = (struct FWL_Sort_Job) {.order = &__order, .left = &__chunks[__i], .right = NULL};
+        __tasks[__i] = (struct FWL_Task) {.run = FWL_sort_chunk, .arg = &__jobs[__i]};
+    }
+    FWL_workers_run(__tasks, __nthreads, __nthreads);
+
+    /* Merge neighbouring chunks level by level, left before right keeps it stable. */
+    for (size_t __width = 1; __width < __nthreads; __width *= 2)
+    {
+        size_t __n = 0;
+        for (size_t __i = 0; __i + __width < __nthreads; __i += 2 * __width, ++__n)
+        {
+            __jobs[__n] = (struct FWL_Sort_Job) {.order = &__order, .left = &__chunks[__i], .right = &__chunks[__i + __width]};
+            __tasks[__n] = (struct FWL_Task) {.run = FWL_merge_chunks, .arg = &__jobs[__n]};
+        }
+        FWL_workers_run(__tasks, __n, __nthreads);
+    }
+    __list->start = __chunks[0].head;
+    __list->finish = __chunks[0].tail;
+    free(__chunks);
+    free(__jobs);
+    free(__tasks);
+}
+
+/* Reads a key and maps it to an unsigned integer with the same ordering. */
+static uint64_t FWL_radix_key(const void* __key, size_t __width, Forward_List_Key_Kind __kind)
+{
+    uint64_t __bits = 0;
+    switch(__width)
+    {
+        case 1: { uint8_t  __k; memcpy(&__k, __key, 1); __bits = __k; break; }
+        case 2: { uint16_t __k; memcpy(&__k, __key, 2); __bits = __k; break; }
+        case 4: { uint32_t __k; memcpy(&__k, __key, 4); __bits = __k; break; }
+        default:{ memcpy(&__bits, __key, 8); break; }
+    }
+    uint64_t __sign = (uint64_t) 1 << (__width * 8 - 1);
+    if(__kind == FWL_KEY_SIGNED)
+    {
+        __bits ^= __sign;
+    }
+    else if(__kind == FWL_KEY_FLOAT)
+    {
+        /* Negative floats order backwards, flip all of their bits. */
+        __bits = (__bits & __sign) ? ~__bits & (__sign | (__sign - 1)) : __bits | __sign;
+    }
+    return __bits;
+}
+
+void FWL_sort_radix(Forward_List* __list, size_t __key_offset, size_t __key_width, Forward_List_Key_Kind __kind)
+{
+    if((__key_width != 1 && __key_width != 2 && __key_width != 4 && __key_width != 8) ||
+       (__kind == FWL_KEY_FLOAT && __key_width != 4 && __key_width != 8))
+    {
+        printf("%s", "FWL_sort_radix(): unsupported key\n");
+        exit(EXIT_FAILURE);
+    }
+    if(!__list->start || !__list->start->next)
+    {
+        return;
+    }
+    FWL_invalidate(__list);
+
+    /* One pass builds the histograms of every byte of the keys. */
+    size_t (*__counts)[256] = (size_t (*)[256]) calloc(__key_width, sizeof(*__counts));
+    if(!__counts)
+    {
+        FWL_exit("FWL_sort_radix()");
+    }
+    for (FWL_iterator __it = __list->start; __it; __it = __it->next)
+    {
+        uint64_t __key = FWL_radix_key((char*) FWL_value(__list, __it) + __key_offset, __key_width, __kind);
+        for (size_t __byte = 0; __byte < __key_width; ++__byte)
+        {
+            ++__counts[__byte][(__key >> (8 * __byte)) & 0xff];
+        }
+    }
+
+    /* Least significant byte first, distributing nodes by relinking. */
+    Forward_List_Node* __heads[256];
+    Forward_List_Node* __tails[256];
+    for (size_t __byte = 0; __byte < __key_width; ++__byte)
+    {
+        uint64_t __key = FWL_radix_key((char*) FWL_value(__list, __list->start) + __key_offset, __key_width, __kind);
+        if(__counts[__byte][(__key >> (8 * __byte)) & 0xff] == __list->count)
+        {
+            continue;
+        }
+        memset(__heads, 0, sizeof(__heads));
+        for (FWL_iterator __it = __list->start; __it; __it = __it->next)
+        {
+            __key = FWL_radix_key((char*) FWL_value(__list, __it) + __key_offset, __key_width, __kind);
+            size_t __digit = (__key >> (8 * __byte)) & 0xff;
+            if(__heads[__digit])
+            {
+                __tails[__digit]->next = __it;
+            }
+            else
+            {
+                __heads[__digit] = __it;
+            }
+            __tails[__digit] = __it;
+        }
+        Forward_List_Node* __tail = (Forward_List_Node*) &__list->start;
+        for (size_t __digit = 0; __digit < 256; ++__digit)
+        {
+            if(__heads[__digit])
+            {
+                __tail->next = __heads[__digit];
+                __tail = __tails[__digit];
+            }
+        }
+        __tail->next = NULL;
+        __list->finish = __tail;
+    }
+    free(__counts);
+}
+
+void FWL_merge(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *))
+{
+    if(__list == __src_list || FWL_empty(__src_list) || !__compare)
+    {
+        return;
+    }
+    FWL_check_splice(__list, __src_list, "FWL_merge()");
+    if(!FWL_empty(__list))
+    {
+        struct FWL_Sort_Order __order = {.list = __list, .greater = __compare, .compare = NULL};
+        struct FWL_Sort_Run __left = {.head = __list->start, .tail = __list->finish, .length = __list->count};
+        struct FWL_Sort_Run __right = {.head = __src_list->start, .tail = __src_list->finish, .length = __src_list->count};
+        FWL_sort_merge(&__order, &__left, &__right);
+        __src_list->start = __left.head;
+        __src_list->finish = __left.tail;
+        __src_list->count = __left.length;
+        FWL_reset(__list);
+    }
+    __FWL_splice_after_list(__list, FWL_before_begin(__list), __src_list);
+}
+
+enum FWL_Set_Operation
+{
+    FWL_SET_UNION,
+    FWL_SET_INTERSECTION,
+    FWL_SET_DIFFERENCE
+};
+
+/*
+ * One linear walk over two sorted lists. Nodes kept in the result are
+ * relinked into __list, the others are collected on a chain and handed
+ * back to the allocator at once.
+ */
+static void FWL_set_operation(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *),
+                              enum FWL_Set_Operation __operation)
+{
+    struct FWL_Sort_Order __order = {.list = __list, .greater = __compare, .compare = NULL};
+    Forward_List_Node __kept = {.next = NULL};
+    Forward_List_Node __dropped = {.next = NULL};
+    Forward_List_Node* __tail = &__kept;
+    Forward_List_Node* __drop = &__dropped;
+    Forward_List_Node* __a = __list->start;
+    Forward_List_Node* __b = __src_list->start;
+    size_t __count = 0;
+    while(__a && __b)
+    {
+        int __take_b = 0;
+        int __keep_a = 0;
+        int __drop_b = 0;
+        if(FWL_sort_greater(&__order, __a, __b))
+        {
+            __take_b = __operation == FWL_SET_UNION;
+            __drop_b = !__take_b;
+        }
+        else if(FWL_sort_greater(&__order, __b, __a))
+        {
+            __keep_a = __operation != FWL_SET_INTERSECTION ? 1 : -1;
+        }
+        else
         {
- 
-            /* If this is first iteration */
-            isFirstIter = 0;
-            if (start1 == *head)
+            __keep_a = __operation != FWL_SET_DIFFERENCE ? 1 : -1;
+            __drop_b = 1;
+        }
+        if(__take_b || __drop_b)
+        {
+            Forward_List_Node* __node = __b;
+            __b = __b->next;
+            if(__take_b)
             {
-                isFirstIter = 1;
+                __tail->next = __node;
+                __tail = __node;
+                ++__count;
             }
- 
-            /* First part for merging */
-            counter = gap;
-            end1 = start1;
-            for (; --counter && end1->next;)
+            else
             {
-                end1 = end1->next;
+                __drop->next = __node;
+                __drop = __node;
             }
- 
-            /* Second part for merging */
-            start2 = end1->next;
-            if (!start2)
+        }
+        if(__keep_a)
+        {
+            Forward_List_Node* __node = __a;
+            __a = __a->next;
+            if(__keep_a > 0)
             {
-                break;
+                __tail->next = __node;
+                __tail = __node;
+                ++__count;
             }
-            
-            counter = gap;
-            end2 = start2;
-            for (; --counter && end2->next;)
+            else
             {
-                end2 = end2->next;
+                __drop->next = __node;
+                __drop = __node;
             }
- 
-            /* To store for next iteration. */
-            temp = end2->next;
+        }
+    }
+    /* What is left of one list once the other one is exhausted. */
+    for (; __a; __a = __a->next)
+    {
+        if(__operation == FWL_SET_INTERSECTION)
+        {
+            __drop->next = __a;
+            __drop = __a;
+        }
+        else
+        {
+            __tail->next = __a;
+            __tail = __a;
+            ++__count;
+        }
+    }
+    for (; __b; __b = __b->next)
+    {
+        if(__operation == FWL_SET_UNION)
+        {
+            __tail->next = __b;
+            __tail = __b;
+            ++__count;
+        }
+        else
+        {
+            __drop->next = __b;
+            __drop = __b;
+        }
+    }
+    __tail->next = NULL;
+    __drop->next = NULL;
+    __list->start = __kept.next;
+    __list->finish = __count ? __tail : NULL;
+    __list->count = __count;
+    FWL_invalidate(__list);
+    FWL_reset(__src_list);
+    size_t __n = (size_t) -1;
+    FWL_put_chain(__list, __dropped.next, NULL, &__n);
+}
 
-            /* ===begin merge=== */
+static void FWL_set_dispatch(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *),
+                             enum FWL_Set_Operation __operation, const char* __func_name)
+{
+    if(!__compare)
+    {
+        return;
+    }
+    if(__list == __src_list)
+    {
+        if(__operation == FWL_SET_DIFFERENCE)
+        {
+            FWL_clear(__list);
+        }
+        return;
+    }
+    FWL_check_splice(__list, __src_list, __func_name);
+    FWL_set_operation(__list, __src_list, __compare, __operation);
+}
 
-            if (__compare(start1->storage, start2->storage)) 
-            {
-                __temp = start1;
-                start1 = start2;
-                start2 = __temp;
+void FWL_set_union(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *))
+{
+    FWL_set_dispatch(__list, __src_list, __compare, FWL_SET_UNION, "FWL_set_union()");
+}
 
-                __temp = end1;
-                end1 = end2;
-                end2 = __temp;
-            }
+void FWL_set_intersection(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *))
+{
+    FWL_set_dispatch(__list, __src_list, __compare, FWL_SET_INTERSECTION, "FWL_set_intersection()");
+}
+
+void FWL_set_difference(Forward_List* __list, Forward_List* __src_list, int (*__compare)(const void *, const void *))
+{
+    FWL_set_dispatch(__list, __src_list, __compare, FWL_SET_DIFFERENCE, "FWL_set_difference()");
+}
+
+/*
+ * Skip list of a sorted %forward_list. Towers are allocated apart from
+ * the nodes and only for some of them, level l of the index linking
+ * about one node in 4^(l+1). The head tower has every level.
+ */
+struct FWL_Skip_Tower
+{
+    Forward_List_Node* node;
+    struct FWL_Skip_Tower* next[];
+};
+
+/* Goes first when comparing less, for lower bounds. */
+#define FWL_SKIP_BEFORE_LESS  0
+/* Goes first when comparing less or equal, for upper bounds. */
+#define FWL_SKIP_BEFORE_EQUAL 1
+
+static int FWL_skip_before(Forward_List* __list, Forward_List_Node* __node, const void* __value, int __mode)
+{
+    if(__mode == FWL_SKIP_BEFORE_LESS)
+    {
+        return __list->skip.compare(__value, FWL_value(__list, __node));
+    }
+    return !__list->skip.compare(FWL_value(__list, __node), __value);
+}
+
+/* Highest level of a new tower, or -1 for no tower. */
+static int FWL_skip_level(Forward_List_Skip* __skip)
+{
+    uint64_t __x = __skip->seed;
+    __x ^= __x << 13;
+    __x ^= __x >> 7;
+    __x ^= __x << 17;
+    __skip->seed = __x;
+    int __level = -1;
+    for (; __level + 1 < FWL_SKIP_MAX_LEVEL && (__x & 3) == 0; __x >>= 2)
+    {
+        ++__level;
+    }
+    return __level;
+}
+
+static void FWL_skip_release(Forward_List_Skip* __skip)
+{
+    struct FWL_Skip_Tower* __head = (struct FWL_Skip_Tower*) __skip->head;
+    if(__head)
+    {
+        for (struct FWL_Skip_Tower* __it = __head->next[0], *__next = NULL; __it; __it = __next)
+        {
+            __next = __it->next[0];
+            free(__it);
+        }
+        free(__head);
+    }
+    __skip->head = NULL;
+    __skip->levels = 0;
+    __skip->valid = 0;
+}
+
+/* Links a tower for __node, given the last tower before it on every level. */
+static int FWL_skip_add(Forward_List_Skip* __skip, struct FWL_Skip_Tower** __update, Forward_List_Node* __node)
+{
+    int __level = FWL_skip_level(__skip);
+    if(__level < 0)
+    {
+        return 1;
+    }
+    struct FWL_Skip_Tower* __tower = (struct FWL_Skip_Tower*) malloc(sizeof(struct FWL_Skip_Tower)
+                                                                    + (__level + 1) * sizeof(struct FWL_Skip_Tower*));
+    if(!__tower)
+    {
+        return 0;
+    }
+    __tower->node = __node;
+    for (int __l = 0; __l <= __level; ++__l)
+    {
+        __tower->next[__l] = __update[__l]->next[__l];
+        __update[__l]->next[__l] = __tower;
+    }
+    if((size_t) __level + 1 > __skip->levels)
+    {
+        __skip->levels = __level + 1;
+    }
+    return 1;
+}
+
+/* Rebuilds a stale skip list in one walk, returns false if it is not usable. */
+static int FWL_skip_ready(Forward_List* __list)
+{
+    Forward_List_Skip* __skip = &__list->skip;
+    if(__skip->valid)
+    {
+        return 1;
+    }
+    FWL_skip_release(__skip);
+    struct FWL_Skip_Tower* __head = (struct FWL_Skip_Tower*) calloc(1, sizeof(struct FWL_Skip_Tower)
+                                                                   + FWL_SKIP_MAX_LEVEL * sizeof(struct FWL_Skip_Tower*));
+    if(!__head)
+    {
+        return 0;
+    }
+    __skip->head = __head;
+    struct FWL_Skip_Tower* __tails[FWL_SKIP_MAX_LEVEL];
+    for (int __l = 0; __l < FWL_SKIP_MAX_LEVEL; ++__l)
+    {
+        __tails[__l] = __head;
+    }
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next)
+    {
+        if(!FWL_skip_add(__skip, __tails, __it))
+        {
+            FWL_skip_release(__skip);
+            return 0;
+        }
+        for (size_t __l = 0; __l < __skip->levels && __tails[__l]->next[__l]; ++__l)
+        {
+            __tails[__l] = __tails[__l]->next[__l];
+        }
+    }
+    __skip->valid = 1;
+    return 1;
+}
 
-            astart = start1;
-            aend = end1;
-            bstart = start2;
-            bendnext = end2->next;
-            for (; astart != aend && bstart != bendnext;)
+/*
+ * Returns the last node going before __value, or FWL_before_begin(), and
+ * stores in __update the last tower going before it on every level.
+ */
+static FWL_iterator FWL_skip_search(Forward_List* __list, const void* __value, int __mode, struct FWL_Skip_Tower** __update)
+{
+    FWL_iterator __position = FWL_before_begin(__list);
+    if(FWL_skip_ready(__list))
+    {
+        struct FWL_Skip_Tower* __tower = (struct FWL_Skip_Tower*) __list->skip.head;
+        for (int __l = FWL_SKIP_MAX_LEVEL - 1; __l >= 0; --__l)
+        {
+            while(__tower->next[__l] && FWL_skip_before(__list, __tower->next[__l]->node, __value, __mode))
             {
-                if (__compare(astart->next->storage, bstart->storage))
-                {
-                    __temp = bstart->next;
-                    bstart->next = astart->next;
-                    astart->next = bstart;
-                    bstart = __temp;
-                }
-                astart = astart->next; 
+                __tower = __tower->next[__l];
             }
-
-            if(astart == aend)
+            if(__update)
             {
-                astart->next = bstart;
+                __update[__l] = __tower;
             }
-            else
+        }
+        if(__tower->node)
+        {
+            __position = __tower->node;
+        }
+    }
+    while(__position->next && FWL_skip_before(__list, __position->next, __value, __mode))
+    {
+        __position = __position->next;
+    }
+    return __position;
+}
+
+static void FWL_check_sorted(Forward_List* __list, const char* __func_name)
+{
+    if(!__list->skip.compare)
+    {
+        printf("%s : list is not sorted\n", __func_name);
+        exit(EXIT_FAILURE);
+    }
+}
+
+void FWL_enable_sorted(Forward_List* __list, int (*__compare)(const void *, const void *))
+{
+    FWL_skip_release(&__list->skip);
+    __list->skip.compare = __compare;
+    if(!__list->skip.seed)
+    {
+        __list->skip.seed = (uint64_t) (uintptr_t) __list | 1;
+    }
+}
+
+FWL_iterator _FWL_insert_sorted(Forward_List* __list, const void* __value)
+{
+    FWL_check_sorted(__list, "FWL_insert_sorted()");
+    struct FWL_Skip_Tower* __update[FWL_SKIP_MAX_LEVEL];
+    FWL_iterator __position = FWL_skip_search(__list, __value, FWL_SKIP_BEFORE_EQUAL, __update);
+    Forward_List_Node* __node = FWL_get_node(__list);
+    memcpy(__node->storage, __value, __list->size);
+    FWL_link_node(__list, __position, __node);
+    if(__list->skip.valid && !FWL_skip_add(&__list->skip, __update, __node))
+    {
+        __list->skip.valid = 0;
+    }
+    return __node;
+}
+
+FWL_iterator _FWL_lower_bound(Forward_List* __list, const void* __value)
+{
+    FWL_check_sorted(__list, "FWL_lower_bound()");
+    return FWL_skip_search(__list, __value, FWL_SKIP_BEFORE_LESS, NULL)->next;
+}
+
+FWL_iterator _FWL_find_sorted(Forward_List* __list, const void* __value)
+{
+    FWL_iterator __it = _FWL_lower_bound(__list, __value);
+    if(__it && !__list->skip.compare(FWL_value(__list, __it), __value))
+    {
+        return __it;
+    }
+    return NULL;
+}
+
+/*
+ * Software prefetching for the walks below. A plain walk cannot run
+ * ahead of itself, finding the node to request means loading every
+ * node before it, so only a valid positional index helps: its entries
+ * are used as jump pointers, and the nodes they reference are requested
+ * FWL_PREFETCH_DISTANCE strides ahead, so that their cache misses
+ * overlap. Without an index the walk is left alone.
+ */
+struct FWL_Prefetch
+{
+    const Forward_List_Index* jumps;
+    size_t position;                /* Position of the node about to be visited. */
+};
+
+static void FWL_prefetch_start(Forward_List* __list, struct FWL_Prefetch* __prefetch, FWL_iterator __before)
+{
+    __prefetch->jumps = NULL;
+    __prefetch->position = 0;
+    if(__before == FWL_before_begin(__list) && __list->index.valid)
+    {
+        __prefetch->jumps = &__list->index;
+        for (size_t __j = 1; __j < FWL_PREFETCH_DISTANCE && __j < __list->index.length; ++__j)
+        {
+            __builtin_prefetch(__list->index.nodes[__j]);
+        }
+    }
+}
+
+/* Called once per node visited, before the node is used. */
+static void FWL_prefetch_step(struct FWL_Prefetch* __prefetch)
+{
+    const Forward_List_Index* __jumps = __prefetch->jumps;
+    if(__jumps && __prefetch->position % __jumps->stride == 0)
+    {
+        size_t __j = __prefetch->position / __jumps->stride + FWL_PREFETCH_DISTANCE;
+        if(__j < __jumps->length)
+        {
+            __builtin_prefetch(__jumps->nodes[__j]);
+        }
+    }
+    ++__prefetch->position;
+}
+
+void FWL_for_each_range(Forward_List* __list, FWL_iterator __before, FWL_iterator __last,
+                        void (*__fn)(void *, void *), void* __ctx)
+{
+    if(!__before || !__fn)
+    {
+        return;
+    }
+    struct FWL_Prefetch __prefetch;
+    FWL_prefetch_start(__list, &__prefetch, __before);
+    for (FWL_iterator __it = __before->next; __it != __last && __it; __it = __it->next)
+    {
+        FWL_prefetch_step(&__prefetch);
+        __fn(FWL_value(__list, __it), __ctx);
+    }
+}
+
+void FWL_for_each(Forward_List* __list, void (*__fn)(void *, void *), void* __ctx)
+{
+    FWL_for_each_range(__list, FWL_before_begin(__list), NULL, __fn, __ctx);
+}
+
+/* Open addressing set of element pointers, probed linearly. */
+struct FWL_Hash_Set
+{
+    struct FWL_Hash_Slot
+    {
+        const void* value;
+        size_t hash;
+    }* slots;
+    size_t mask;
+    size_t (*hash)(const void *);
+    int (*equal)(const void *, const void *);
+};
+
+/* Sized for at most __n values, the load factor stays below one half. */
+static void FWL_hash_init(struct FWL_Hash_Set* __set, size_t __n, size_t (*__hash)(const void *),
+                          int (*__equal)(const void *, const void *), const char* __func_name)
+{
+    size_t __capacity = 16;
+    while(__capacity < 2 * __n)
+    {
+        __capacity *= 2;
+    }
+    __set->slots = (struct FWL_Hash_Slot*) calloc(__capacity, sizeof(struct FWL_Hash_Slot));
+    if(!__set->slots)
+    {
+        FWL_exit(__func_name);
+    }
+    __set->mask = __capacity - 1;
+    __set->hash = __hash;
+    __set->equal = __equal;
+}
+
+/*
+ * Looks for a value equal to __value. When there is none and __insert is
+ * set, __value is added. Returns true if an equal value was found.
+ */
+static int FWL_hash_probe(struct FWL_Hash_Set* __set, const void* __value, int __insert)
+{
+    size_t __hash = __set->hash(__value);
+    for (size_t __i = __hash & __set->mask; ; __i = (__i + 1) & __set->mask)
+    {
+        struct FWL_Hash_Slot* __slot = __set->slots + __i;
+        if(!__slot->value)
+        {
+            if(__insert)
             {
-                end2 = end1;
+                __slot->value = __value;
+                __slot->hash = __hash;
             }
+            return 0;
+        }
+        if(__slot->hash == __hash && __set->equal(__slot->value, __value))
+        {
+            return 1;
+        }
+    }
+}
+
+/* Which elements a filtering walk selects, exactly one way is set. */
+struct FWL_Filter
+{
+    int (*predicate)(const void *);                 /* Elements satisfying it. */
+    int (*compare)(const void *, const void *);     /* Elements equal to value. */
+    const void* value;
+    struct FWL_Hash_Set* set;                       /* Elements found in it. */
+    int insert;                                     /* Adds the elements not found to set. */
+};
 
-            /* ===end merge=== */
-            
-            /* Update head for first iteration, else append after previous list */
-            if (isFirstIter)
-            {
-                *head = start1;
-            }
-            else
-            {
-                prevend->next = start1;
-            }
- 
-            prevend = end2;
-            start1 = temp;
+static int FWL_filter_match(const struct FWL_Filter* __filter, const void* __value)
+{
+    if(__filter->predicate)
+    {
+        return __filter->predicate(__value);
+    }
+    if(__filter->compare)
+    {
+        return __filter->compare(__filter->value, __value);
+    }
+    return FWL_hash_probe(__filter->set, __value, __filter->insert);
+}
+
+/*
+ * Unlinks the elements selected by the filter, in one prefetching pass
+ * and in list order, and hands them over to __matched, which shares the
+ * settings of __list so it can be spliced back anywhere __list could.
+ */
+static size_t FWL_split_if(Forward_List* __list, const struct FWL_Filter* __filter, Forward_List* __matched)
+{
+    Forward_List_Node __head = {.next = NULL};
+    Forward_List_Node* __tail = &__head;
+    Forward_List_Node* __kept = NULL;
+    size_t __n = 0;
+    struct FWL_Prefetch __prefetch;
+    FWL_prefetch_start(__list, &__prefetch, FWL_before_begin(__list));
+    for (FWL_iterator __it = FWL_before_begin(__list); __it->next != NULL; )
+    {
+        Forward_List_Node* __node = __it->next;
+        FWL_prefetch_step(&__prefetch);
+        if(FWL_filter_match(__filter, FWL_value(__list, __node)))
+        {
+            __it->next = __node->next;
+            __tail->next = __node;
+            __tail = __node;
+            ++__n;
         }
-        prevend->next = start1;
+        else
+        {
+            __kept = __node;
+            __it = __node;
+        }
+    }
+    __tail->next = NULL;
+    __list->finish = __kept;
+    __list->count -= __n;
+    FWL_invalidate(__list);
+    *__matched = *__list;
+    memset(&__matched->index, 0, sizeof(__matched->index));
+    memset(&__matched->skip, 0, sizeof(__matched->skip));
+    __matched->start = __head.next;
+    __matched->finish = __n ? __tail : NULL;
+    __matched->count = __n;
+    return __n;
+}
+
+/* Erases the elements selected by the filter, releasing them together. */
+static void FWL_erase_if(Forward_List* __list, const struct FWL_Filter* __filter)
+{
+    Forward_List __matched;
+    if(FWL_split_if(__list, __filter, &__matched))
+    {
+        size_t __n = (size_t) -1;
+        FWL_put_chain(__list, __matched.start, NULL, &__n);
     }
-    __list->finish = end2;
 }
 
 void _FWL_remove(Forward_List* __list, const void* __valuePtr, int (*__compare)(const void *, const void *))
 {
     if(!FWL_empty(__list))
     {
-    	for (FWL_iterator __it = FWL_begin(__list); __it && __it->next != NULL; )
-    	{
-	    if(__compare(__valuePtr, __it->next->storage))
-	    {
-		__it = FWL_pop_after(__list, __it);
-	    }
-	    else
-	    {
-	    	__it = __it->next;
-	    }
-        }
-    	if(__compare(__valuePtr, __list->start->storage))
-    	{
-	    FWL_pop_front(__list);
-    	}    
+        struct FWL_Filter __filter = {.compare = __compare, .value = __valuePtr};
+        FWL_erase_if(__list, &__filter);
     }
 }
 
@@ -518,22 +2443,315 @@ void FWL_remove_if(Forward_List* __list, int (*__predicate)(const void *))
 {
     if(!FWL_empty(__list))
     {
-    	for (FWL_iterator __it = FWL_begin(__list); __it && __it->next != NULL; )
-    	{
-	    if(__predicate(__it->next->storage))
-	    {
-	    	__it = FWL_pop_after(__list, __it);
-	    }
-	    else
-	    {
-	    	__it = __it->next;
-	    }
+        struct FWL_Filter __filter = {.predicate = __predicate};
+        FWL_erase_if(__list, &__filter);
+    }
+}
+
+size_t FWL_extract_if(Forward_List* __list, int (*__predicate)(const void *), Forward_List* __out_list)
+{
+    if(FWL_empty(__list) || !__predicate || __list == __out_list)
+    {
+        return 0;
+    }
+    FWL_check_splice(__out_list, __list, "FWL_extract_if()");
+    Forward_List __matched;
+    struct FWL_Filter __filter = {.predicate = __predicate};
+    size_t __n = FWL_split_if(__list, &__filter, &__matched);
+    if(__n)
+    {
+        __FWL_splice_after_list(__out_list, FWL_rbegin(__out_list), &__matched);
+    }
+    return __n;
+}
+
+size_t FWL_partition(Forward_List* __list, int (*__predicate)(const void *), Forward_List* __out_list)
+{
+    if(__out_list)
+    {
+        return FWL_extract_if(__list, __predicate, __out_list);
+    }
+    if(FWL_empty(__list) || !__predicate)
+    {
+        return 0;
+    }
+    Forward_List __matched;
+    struct FWL_Filter __filter = {.predicate = __predicate};
+    size_t __n = FWL_split_if(__list, &__filter, &__matched);
+    if(__n)
+    {
+        __FWL_splice_after_list(__list, FWL_before_begin(__list), &__matched);
+    }
+    return __n;
+}
+
+void FWL_unique_hashed(Forward_List* __list, size_t (*__hash)(const void *), int (*__equal)(const void *, const void *))
+{
+    if(!__list->start || !__list->start->next || !__hash || !__equal)
+    {
+        return;
+    }
+    struct FWL_Hash_Set __set;
+    FWL_hash_init(&__set, __list->count, __hash, __equal, "FWL_unique_hashed()");
+    struct FWL_Filter __filter = {.set = &__set, .insert = 1};
+    FWL_erase_if(__list, &__filter);
+    free(__set.slots);
+}
+
+void FWL_remove_any(Forward_List* __list, const void* __values, size_t __k, size_t (*__hash)(const void *),
+                    int (*__equal)(const void *, const void *))
+{
+    if(FWL_empty(__list) || !__k || !__hash || !__equal)
+    {
+        return;
+    }
+    struct FWL_Hash_Set __set;
+    FWL_hash_init(&__set, __k, __hash, __equal, "FWL_remove_any()");
+    for (size_t __i = 0; __i < __k; ++__i)
+    {
+        FWL_hash_probe(&__set, (const char*) __values + __i * __list->size, 1);
+    }
+    struct FWL_Filter __filter = {.set = &__set, .insert = 0};
+    FWL_erase_if(__list, &__filter);
+    free(__set.slots);
+}
+
+/*
+ * Parallel walks. The list is cut into FWL_PARALLEL_CHUNKS chunks per
+ * thread in one pass, the chunks are run as tasks of the worker threads
+ * and their results are put together by the caller in list order.
+ */
+struct FWL_Parallel_Job
+{
+    Forward_List* list;
+    struct FWL_Sort_Run chunk;
+    FWL_iterator before;                        /* Node before the chunk while the list stays linked. */
+    void (*fn)(void *, void *);
+    void* ctx;
+    int (*predicate)(const void *);
+    void (*accumulate)(void *, const void *);
+    void* acc;
+    size_t count;
+    Forward_List matched;
+};
+
+/*
+ * Locates or, with __detach, cuts the chunks and prepares one job and
+ * one task per chunk. *__nthreads is lowered by FWL_workers_clamp().
+ * Returns the number of chunks, or zero
+ * when the list is better walked sequentially, too short for the
+ * threads to pay off, called from a task of the pool or the bookkeeping
+ * could not be allocated, in which case the list is left untouched.
+ */
+static size_t FWL_parallel_begin(Forward_List* __list, size_t* __nthreads, int __detach, void (*__run)(void *),
+                                 struct FWL_Parallel_Job** __jobs, struct FWL_Task** __tasks)
+{
+    *__nthreads = FWL_workers_clamp(__list, *__nthreads);
+    if(*__nthreads < 2)
+    {
+        return 0;
+    }
+    size_t __n = *__nthreads * FWL_PARALLEL_CHUNKS;
+    struct FWL_Sort_Run* __chunks = (struct FWL_Sort_Run*) malloc(__n * sizeof(struct FWL_Sort_Run));
+    *__jobs = (struct FWL_Parallel_Job*) calloc(__n, sizeof(struct FWL_Parallel_Job));
+    *__tasks = (struct FWL_Task*) malloc(__n * sizeof(struct FWL_Task));
+    if(!__chunks || !*__jobs || !*__tasks)
+    {
+        free(__chunks);
+        free(*__jobs);
+        free(*__tasks);
+        return 0;
+    }
+    FWL_split_chunks(__list, __chunks, __n, __detach);
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        (*__jobs)[__i].list = __list;
+        (*__jobs)[__i].chunk = __chunks[__i];
+        (*__jobs)[__i].before = __i ? __chunks[__i - 1].tail : FWL_before_begin(__list);
+        (*__tasks)[__i] = (struct FWL_Task) {.run = __run, .arg = &(*__jobs)[__i]};
+    }
+    free(__chunks);
+    return __n;
+}
+
+/* Walks a chunk of a list left linked. */
+static void FWL_parallel_walk(void* __arg)
+{
+    struct FWL_Parallel_Job* __job = (struct FWL_Parallel_Job*) __arg;
+    FWL_for_each_range(__job->list, __job->before, __job->chunk.tail->next, __job->fn, __job->ctx);
+}
+
+static void FWL_parallel_count(void* __value, void* __ctx)
+{
+    struct FWL_Parallel_Job* __job = (struct FWL_Parallel_Job*) __ctx;
+    __job->count += __job->predicate(__value) != 0;
+}
+
+static void FWL_parallel_accumulate(void* __value, void* __ctx)
+{
+    struct FWL_Parallel_Job* __job = (struct FWL_Parallel_Job*) __ctx;
+    __job->accumulate(__job->acc, __value);
+}
+
+/* Unlinks the matching elements of a detached chunk. */
+static void FWL_parallel_split(void* __arg)
+{
+    struct FWL_Parallel_Job* __job = (struct FWL_Parallel_Job*) __arg;
+    Forward_List __chunk = *__job->list;
+    __chunk.start = __job->chunk.head;
+    __chunk.finish = __job->chunk.tail;
+    __chunk.count = __job->chunk.length;
+    struct FWL_Filter __filter = {.predicate = __job->predicate};
+    __job->count = FWL_split_if(&__chunk, &__filter, &__job->matched);
+    __job->chunk.head = __chunk.start;
+    __job->chunk.tail = __chunk.finish;
+    __job->chunk.length = __chunk.count;
+}
+
+void FWL_parallel_for_each(Forward_List* __list, void (*__fn)(void *, void *), void* __ctx, size_t __nthreads)
+{
+    if(!__fn)
+    {
+        return;
+    }
+    struct FWL_Parallel_Job* __jobs = NULL;
+    struct FWL_Task* __tasks = NULL;
+    size_t __n = FWL_parallel_begin(__list, &__nthreads, 0, FWL_parallel_walk, &__jobs, &__tasks);
+    if(!__n)
+    {
+        FWL_for_each(__list, __fn, __ctx);
+        return;
+    }
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __jobs[__i].fn = __fn;
+        __jobs[__i].ctx = __ctx;
+    }
+    FWL_workers_run(__tasks, __n, __nthreads);
+    free(__jobs);
+    free(__tasks);
+}
+
+size_t FWL_parallel_count_if(Forward_List* __list, int (*__predicate)(const void *), size_t __nthreads)
+{
+    if(!__predicate)
+    {
+        return 0;
+    }
+    struct FWL_Parallel_Job* __jobs = NULL;
+    struct FWL_Task* __tasks = NULL;
+    size_t __n = FWL_parallel_begin(__list, &__nthreads, 0, FWL_parallel_walk, &__jobs, &__tasks);
+    if(!__n)
+    {
+        struct FWL_Parallel_Job __job = {.predicate = __predicate};
+        FWL_for_each(__list, FWL_parallel_count, &__job);
+        return __job.count;
+    }
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __jobs[__i].fn = FWL_parallel_count;
+        __jobs[__i].ctx = &__jobs[__i];
+        __jobs[__i].predicate = __predicate;
+    }
+    FWL_workers_run(__tasks, __n, __nthreads);
+    size_t __count = 0;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __count += __jobs[__i].count;
+    }
+    free(__jobs);
+    free(__tasks);
+    return __count;
+}
+
+void FWL_parallel_reduce(Forward_List* __list, void* __result, size_t __result_size,
+                         void (*__accumulate)(void *, const void *), void (*__combine)(void *, const void *),
+                         size_t __nthreads)
+{
+    if(!__accumulate || !__combine)
+    {
+        return;
+    }
+    struct FWL_Parallel_Job* __jobs = NULL;
+    struct FWL_Task* __tasks = NULL;
+    size_t __n = FWL_parallel_begin(__list, &__nthreads, 0, FWL_parallel_walk, &__jobs, &__tasks);
+    char* __accs = __n ? (char*) malloc(__n * __result_size) : NULL;
+    if(!__accs)
+    {
+        free(__jobs);
+        free(__tasks);
+        struct FWL_Parallel_Job __job = {.accumulate = __accumulate, .acc = __result};
+        FWL_for_each(__list, FWL_parallel_accumulate, &__job);
+        return;
+    }
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        memcpy(__accs + __i * __result_size, __result, __result_size);
+        __jobs[__i].fn = FWL_parallel_accumulate;
+        __jobs[__i].ctx = &__jobs[__i];
+        __jobs[__i].accumulate = __accumulate;
+        __jobs[__i].acc = __accs + __i * __result_size;
+    }
+    FWL_workers_run(__tasks, __n, __nthreads);
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __combine(__result, __jobs[__i].acc);
+    }
+    free(__accs);
+    free(__jobs);
+    free(__tasks);
+}
+
+size_t FWL_parallel_remove_if(Forward_List* __list, int (*__predicate)(const void *), size_t __nthreads)
+{
+    if(FWL_empty(__list) || !__predicate)
+    {
+        return 0;
+    }
+    FWL_invalidate(__list);
+    struct FWL_Parallel_Job* __jobs = NULL;
+    struct FWL_Task* __tasks = NULL;
+    size_t __n = FWL_parallel_begin(__list, &__nthreads, 1, FWL_parallel_split, &__jobs, &__tasks);
+    if(!__n)
+    {
+        size_t __count = __list->count;
+        FWL_remove_if(__list, __predicate);
+        return __count - __list->count;
+    }
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __jobs[__i].predicate = __predicate;
+    }
+    FWL_workers_run(__tasks, __n, __nthreads);
+
+    /* Stitch the kept chains back, then release the others on this thread. */
+    Forward_List_Node __head = {.next = NULL};
+    Forward_List_Node* __tail = &__head;
+    size_t __removed = 0;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        if(__jobs[__i].chunk.length)
+        {
+            __tail->next = __jobs[__i].chunk.head;
+            __tail = __jobs[__i].chunk.tail;
+        }
+        __removed += __jobs[__i].count;
+    }
+    __tail->next = NULL;
+    __list->start = __head.next;
+    __list->finish = __list->start ? __tail : NULL;
+    __list->count -= __removed;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        if(__jobs[__i].count)
+        {
+            size_t __released = (size_t) -1;
+            FWL_put_chain(__list, __jobs[__i].matched.start, NULL, &__released);
         }
-    	if(__predicate(__list->start->storage))
-    	{
-	    FWL_pop_front(__list);
-    	}
     }
+    free(__jobs);
+    free(__tasks);
+    return __removed;
 }
 
 void FWL_unique(Forward_List* __list, int (*__compare)(const void *, const void *))
@@ -544,7 +2762,7 @@ void FWL_unique(Forward_List* __list, int (*__compare)(const void *, const void
     }
     for (FWL_iterator __it = FWL_begin(__list); __it && __it->next != NULL; )
     {
-        if(__compare(__it->storage, __it->next->storage))
+        if(__compare(FWL_value(__list, __it), FWL_value(__list, __it->next)))
         {
             __it = FWL_pop_after(__list, __it);
         }
@@ -555,6 +2773,123 @@ void FWL_unique(Forward_List* __list, int (*__compare)(const void *, const void
     }
 }
 
+static int FWL_address_order(const void* __a, const void* __b)
+{
+    uintptr_t __x = (uintptr_t) *(Forward_List_Node* const*) __a;
+    uintptr_t __y = (uintptr_t) *(Forward_List_Node* const*) __b;
+    return (__x > __y) - (__x < __y);
+}
+
+/*
+ * Allocates __n fresh nodes like FWL_get_nodes(). Arena nodes are
+ * carved in order already. Heap and pool nodes come from malloc() or
+ * per-thread caches in no particular order, so they are relinked by
+ * increasing address.
+ */
+static Forward_List_Node* FWL_compact_nodes(Forward_List* __list, size_t __n, Forward_List_Node** __last)
+{
+    Forward_List_Node* __first = FWL_get_nodes(__list, __n, __last);
+    if(__list->allocator == FWL_ALLOC_ARENA || __n < 2)
+    {
+        return __first;
+    }
+    Forward_List_Node** __nodes = (Forward_List_Node**) malloc(__n * sizeof(Forward_List_Node*));
+    if(!__nodes)
+    {
+        return __first;
+    }
+    size_t __i = 0;
+    for (Forward_List_Node* __it = __first; __it; __it = __it->next)
+    {
+        __nodes[__i++] = __it;
+    }
+    qsort(__nodes, __n, sizeof(Forward_List_Node*), FWL_address_order);
+    for (__i = 0; __i + 1 < __n; ++__i)
+    {
+        __nodes[__i]->next = __nodes[__i + 1];
+    }
+    __nodes[__n - 1]->next = NULL;
+    __first = __nodes[0];
+    *__last = __nodes[__n - 1];
+    free(__nodes);
+    return __first;
+}
+
+/* Copies the elements of the chain at __src into the chain at __dst. */
+static void FWL_copy_chain(Forward_List* __list, Forward_List_Node* __dst, Forward_List_Node* __src, size_t __n)
+{
+    for (; __n; --__n, __dst = __dst->next, __src = __src->next)
+    {
+        memcpy(__dst->storage, __src->storage, __list->size);
+    }
+}
+
+void FWL_compact(Forward_List* __list)
+{
+    if(FWL_empty(__list))
+    {
+        return;
+    }
+    if(__list->allocator == FWL_ALLOC_NONE)
+    {
+        FWL_exit_intrusive("FWL_compact()");
+    }
+    Forward_List_Node* __old = __list->start;
+    Forward_List_Node* __first = NULL;
+    Forward_List_Node* __last = NULL;
+    if(__list->allocator == FWL_ALLOC_ARENA)
+    {
+        /* Move into a new arena sized for the list and drop the old one whole. */
+        Forward_List_Arena __arena = __list->arena;
+        memset(&__list->arena, 0, sizeof(__list->arena));
+        __list->arena.slab_nodes = __arena.slab_nodes;
+        __first = FWL_get_nodes(__list, __list->count, &__last);
+        FWL_copy_chain(__list, __first, __old, __list->count);
+        FWL_arena_release(&__arena);
+    }
+    else
+    {
+        __first = FWL_compact_nodes(__list, __list->count, &__last);
+        FWL_copy_chain(__list, __first, __old, __list->count);
+        size_t __n = (size_t) -1;
+        FWL_put_chain(__list, __old, NULL, &__n);
+    }
+    __list->start = __first;
+    __list->finish = __last;
+    FWL_invalidate(__list);
+}
+
+FWL_iterator FWL_compact_some(Forward_List* __list, FWL_iterator __before, size_t __n)
+{
+    if(!__before || !__before->next || !__n)
+    {
+        return NULL;
+    }
+    if(__list->allocator == FWL_ALLOC_NONE)
+    {
+        FWL_exit_intrusive("FWL_compact_some()");
+    }
+    Forward_List_Node* __old = __before->next;
+    Forward_List_Node* __old_last = __old;
+    size_t __k = 1;
+    for (; __k < __n && __old_last->next; ++__k)
+    {
+        __old_last = __old_last->next;
+    }
+    Forward_List_Node* __last = NULL;
+    Forward_List_Node* __first = FWL_compact_nodes(__list, __k, &__last);
+    FWL_copy_chain(__list, __first, __old, __k);
+    __before->next = __first;
+    __last->next = __old_last->next;
+    if(__list->finish == __old_last)
+    {
+        __list->finish = __last;
+    }
+    FWL_put_chain(__list, __old, __last->next, &__k);
+    FWL_invalidate(__list);
+    return __last;
+}
+
 void FWL_reverse(Forward_List* __list)
 {
     Forward_List_Node* current = FWL_begin(__list);
@@ -574,19 +2909,17 @@ void FWL_reverse(Forward_List* __list)
     }
     __list->start = prev;
     __list->finish = start;
+    FWL_invalidate(__list);
 }
 
 static void FWL_truncate(Forward_List* __list, FWL_iterator __curr, FWL_iterator __prev)
 {
-    Forward_List_Node* __temp = NULL;
-    for (; __curr != NULL; --__list->count)
-    {
-        __temp = __curr;
-        __curr = __curr->next;
-        free(__temp);
-    }
+    size_t __n = (size_t) -1;
+    FWL_put_chain(__list, __curr, NULL, &__n);
+    __list->count -= __n;
     __list->finish = __prev;
     __list->finish->next = NULL;
+    FWL_invalidate(__list);
 }
 
 static void FWL_shrink_list(Forward_List* __list, size_t __n)
@@ -607,6 +2940,7 @@ static void FWL_shrink_list(Forward_List* __list, size_t __n)
 static void FWL_extend_list(Forward_List* __list, size_t __n)
 {
     Forward_List_Node *__node = NULL;
+    FWL_invalidate(__list);
     if(FWL_empty(__list))
     {
         for (; __list->count < __n; ++__list->count)
@@ -646,6 +2980,108 @@ void FWL_resize(Forward_List* __list, size_t __n)
     }
 }
 
+/* Builds a chain holding copies of __n elements and splices it after position. */
+static FWL_iterator FWL_splice_array(Forward_List* __list, FWL_iterator __position, const void* __data, size_t __n)
+{
+    Forward_List_Node* __last = NULL;
+    Forward_List_Node* __first = FWL_get_nodes(__list, __n, &__last);
+    const Forward_List_Generic* __src = (const Forward_List_Generic*) __data;
+    for (Forward_List_Node* __it = __first; __it; __it = __it->next, __src += __list->size)
+    {
+        memcpy(__it->storage, __src, __list->size);
+    }
+    Forward_List __chain = {.start = __first, .finish = __last, .count = __n, .size = __list->size};
+    __FWL_splice_after_list(__list, __position, &__chain);
+    return __last;
+}
+
+FWL_iterator FWL_insert_after_array(Forward_List* __list, FWL_iterator __position, const void* __data, size_t __n)
+{
+    if(!__n)
+    {
+        return __position;
+    }
+    /* FWL_rbegin() of an empty list, inserting anywhere fills the list. */
+    if(!__position && FWL_empty(__list))
+    {
+        __position = FWL_before_begin(__list);
+    }
+    if(!__position)
+    {
+        return __position;
+    }
+    return FWL_splice_array(__list, __position, __data, __n);
+}
+
+void FWL_from_array(Forward_List* __list, const void* __data, size_t __n)
+{
+    if(__list->allocator == FWL_ALLOC_NONE)
+    {
+        FWL_exit_intrusive("FWL_from_array()");
+    }
+    const Forward_List_Generic* __src = (const Forward_List_Generic*) __data;
+    FWL_iterator __prev = NULL;
+    FWL_iterator __it = FWL_begin(__list);
+    for (; __it && __n; __prev = __it, __it = __it->next, __src += __list->size, --__n)
+    {
+        memcpy(__it->storage, __src, __list->size);
+    }
+    if(!__prev)
+    {
+        FWL_clear(__list);
+    }
+    else if(__it)
+    {
+        FWL_truncate(__list, __it, __prev);
+    }
+    if(__n)
+    {
+        FWL_splice_array(__list, FWL_rbegin(__list) ? FWL_rbegin(__list) : FWL_before_begin(__list), __src, __n);
+    }
+}
+
+size_t FWL_to_array(Forward_List* __list, void* __out)
+{
+    Forward_List_Generic* __dst = (Forward_List_Generic*) __out;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, __dst += __list->size)
+    {
+        memcpy(__dst, FWL_value(__list, __it), __list->size);
+    }
+    return __list->count;
+}
+
+Forward_List _FWL_copy(Forward_List* __list)
+{
+    Forward_List __copy = *__list;
+    __copy.start = NULL;
+    __copy.finish = NULL;
+    __copy.count = 0;
+    memset(&__copy.arena, 0, sizeof(__copy.arena));
+    __copy.arena.slab_nodes = __list->arena.slab_nodes;
+    memset(&__copy.index, 0, sizeof(__copy.index));
+    __copy.index.stride = __list->index.stride;
+    memset(&__copy.skip, 0, sizeof(__copy.skip));
+    FWL_enable_sorted(&__copy, __list->skip.compare);
+    if(FWL_empty(__list))
+    {
+        return __copy;
+    }
+    if(__list->allocator == FWL_ALLOC_NONE)
+    {
+        FWL_exit_intrusive("FWL_copy()");
+    }
+    Forward_List_Node* __last = NULL;
+    Forward_List_Node* __first = FWL_get_nodes(&__copy, __list->count, &__last);
+    for (FWL_iterator __src = FWL_begin(__list), __dst = __first; __src; __src = __src->next, __dst = __dst->next)
+    {
+        memcpy(__dst->storage, __src->storage, __list->size);
+    }
+    __copy.start = __first;
+    __copy.finish = __last;
+    __copy.count = __list->count;
+    return __copy;
+}
+
 void FWL_swap(Forward_List* __list1, Forward_List* __list2)
 {
     if(__list1->size != __list2->size)
@@ -660,24 +3096,65 @@ void FWL_swap(Forward_List* __list1, Forward_List* __list2)
 
 void FWL_clear(Forward_List* __list)
 {
-    if(FWL_empty(__list))
+    FWL_index_release(&__list->index);
+    FWL_skip_release(&__list->skip);
+    if(__list->allocator == FWL_ALLOC_ARENA)
     {
+        FWL_arena_release(&__list->arena);
+        FWL_reset(__list);
         return;
     }
-    Forward_List_Node* __temp = NULL;
-    for (Forward_List_Node* __it = FWL_begin(__list); __it != NULL; )
+    if(__list->allocator == FWL_ALLOC_NONE)
     {
-        __temp = __it;
-        __it = __it->next;
-        free(__temp);
+        FWL_reset(__list);
+        return;
+    }
+    if(FWL_empty(__list))
+    {
+        return;
     }
+    size_t __n = (size_t) -1;
+    FWL_put_chain(__list, FWL_begin(__list), NULL, &__n);
     FWL_reset(__list);
 }
 
 Forward_List FWL_Init(size_t __size)
 {
     Forward_List temp = {.start = NULL, .finish = NULL, 
-                         .count = 0,   .size = __size};
+                         .count = 0,   .size = __size,
+                         .offset = offsetof(Forward_List_Node, storage),
+                         .allocator = FWL_ALLOC_HEAP};
+    return temp;
+}
+
+Forward_List _FWL_Init_intrusive(size_t __size, size_t __link_offset)
+{
+    Forward_List temp = FWL_Init(__size);
+    temp.offset = -(ptrdiff_t) __link_offset;
+    temp.allocator = FWL_ALLOC_NONE;
+    return temp;
+}
+
+Forward_List FWL_Init_arena(size_t __size, size_t __slab_nodes)
+{
+    Forward_List temp = FWL_Init(__size);
+    if(__slab_nodes == 0)
+    {
+        __slab_nodes = FWL_ARENA_SLAB_BYTES / FWL_node_size(__size);
+        if(__slab_nodes == 0)
+        {
+            __slab_nodes = 1;
+        }
+    }
+    temp.allocator = FWL_ALLOC_ARENA;
+    temp.arena.slab_nodes = __slab_nodes;
+    return temp;
+}
+
+Forward_List FWL_Init_pooled(size_t __size)
+{
+    Forward_List temp = FWL_Init(__size);
+    temp.allocator = FWL_ALLOC_POOL;
     return temp;
 }
 
@@ -0,0 +1,370 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/forward_list32.h"
+
+/* Nodes reserved by the first insertion, the sentinel included. */
+#define FWL32_INITIAL_NODES 16
+
+static void FWL32_exit(const char* __func_name)
+{
+    printf("%s : Out of memory\n", __func_name);
+    exit(EXIT_FAILURE);
+}
+
+static int FWL32_grow(Forward_List32* __list)
+{
+    uint64_t __capacity = __list->capacity ? 2 * (uint64_t) __list->capacity : FWL32_INITIAL_NODES;
+    if(__capacity > FWL32_NIL)
+    {
+        __capacity = FWL32_NIL;
+    }
+    if(__capacity <= __list->capacity)
+    {
+        return 0;
+    }
+    Forward_List_Generic* __nodes = (Forward_List_Generic*) realloc(__list->nodes, __capacity * __list->stride);
+    if(!__nodes)
+    {
+        return 0;
+    }
+    if(!__list->nodes)
+    {
+        __list->used = 1;
+        *(uint32_t*) __nodes = FWL32_NIL;
+    }
+    __list->nodes = __nodes;
+    __list->capacity = (uint32_t) __capacity;
+    return 1;
+}
+
+static FWL32_iterator FWL32_get_node(Forward_List32* __list)
+{
+    FWL32_iterator __node = __list->free_nodes;
+    if(__node != FWL32_NIL)
+    {
+        __list->free_nodes = FWL32_link(__list, __node);
+    }
+    else
+    {
+        if(__list->used == __list->capacity && !FWL32_grow(__list))
+        {
+            FWL32_clear(__list);
+            FWL32_exit("FWL32_get_node()");
+        }
+        __node = __list->used++;
+    }
+    FWL32_link(__list, __node) = FWL32_NIL;
+    memset(FWL32_storage(__list, __node), 0, __list->size);
+    return __node;
+}
+
+static void FWL32_put_node(Forward_List32* __list, FWL32_iterator __node)
+{
+    FWL32_link(__list, __node) = __list->free_nodes;
+    __list->free_nodes = __node;
+}
+
+FWL32_iterator FWL32_before_begin(Forward_List32* __list)
+{
+    (void) __list;
+    return FWL32_BEFORE_BEGIN;
+}
+
+FWL32_iterator FWL32_begin(Forward_List32* __list)
+{
+    if(!__list->nodes)
+    {
+        return FWL32_NIL;
+    }
+    return FWL32_link(__list, FWL32_BEFORE_BEGIN);
+}
+
+FWL32_iterator FWL32_rbegin(Forward_List32* __list)
+{
+    if(__list->finish == FWL32_NIL)
+    {
+        return FWL32_BEFORE_BEGIN;
+    }
+    return __list->finish;
+}
+
+FWL32_iterator FWL32_end(Forward_List32* __list)
+{
+    (void) __list;
+    return FWL32_NIL;
+}
+
+/* Links an unlinked node after position, keeping finish up to date. */
+static void FWL32_link_after(Forward_List32* __list, FWL32_iterator __position, FWL32_iterator __node)
+{
+    FWL32_link(__list, __node) = FWL32_link(__list, __position);
+    FWL32_link(__list, __position) = __node;
+    if(FWL32_link(__list, __node) == FWL32_NIL)
+    {
+        __list->finish = __node;
+    }
+    ++__list->count;
+}
+
+/* Unlinks the node following position without releasing it. */
+static FWL32_iterator FWL32_unlink_after(Forward_List32* __list, FWL32_iterator __position)
+{
+    FWL32_iterator __node = FWL32_link(__list, __position);
+    FWL32_link(__list, __position) = FWL32_link(__list, __node);
+    if(__list->finish == __node)
+    {
+        __list->finish = __position == FWL32_BEFORE_BEGIN ? FWL32_NIL : __position;
+    }
+    --__list->count;
+    return __node;
+}
+
+FWL32_iterator _FWL32_insert_after(Forward_List32* __list, FWL32_iterator __position, void** __storage)
+{
+    FWL32_iterator __node = FWL32_get_node(__list);
+    FWL32_link_after(__list, __position, __node);
+    *__storage = FWL32_storage(__list, __node);
+    return __node;
+}
+
+void FWL32_pop_front(Forward_List32* __list)
+{
+    FWL32_pop_after(__list, FWL32_BEFORE_BEGIN);
+}
+
+FWL32_iterator FWL32_pop_after(Forward_List32* __list, FWL32_iterator __position)
+{
+    if(FWL32_empty(__list) || __position == FWL32_NIL || FWL32_link(__list, __position) == FWL32_NIL)
+    {
+        return FWL32_NIL;
+    }
+    FWL32_put_node(__list, FWL32_unlink_after(__list, __position));
+    return FWL32_link(__list, __position);
+}
+
+FWL32_iterator FWL32_erase_after(Forward_List32* __list, FWL32_iterator __before, FWL32_iterator __last)
+{
+    if(FWL32_empty(__list) || __before == FWL32_NIL)
+    {
+        return __last;
+    }
+    while(FWL32_link(__list, __before) != __last && FWL32_link(__list, __before) != FWL32_NIL)
+    {
+        FWL32_pop_after(__list, __before);
+    }
+    return __last;
+}
+
+/* Moves the node following __i in src_list after position in list. */
+static FWL32_iterator FWL32_move_after(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list,
+                                                                                         FWL32_iterator __i)
+{
+    if(__list == __src_list)
+    {
+        FWL32_iterator __node = FWL32_unlink_after(__list, __i);
+        FWL32_link_after(__list, __position, __node);
+        return __node;
+    }
+    void* __storage = NULL;
+    FWL32_iterator __node = _FWL32_insert_after(__list, __position, &__storage);
+    FWL32_iterator __src = FWL32_link(__src_list, __i);
+    memcpy(__storage, FWL32_storage(__src_list, __src), __list->size);
+    FWL32_pop_after(__src_list, __i);
+    return __node;
+}
+
+void FWL32_splice_after_list(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list)
+{
+    if(__list == __src_list || __position == FWL32_NIL)
+    {
+        return;
+    }
+    while(!FWL32_empty(__src_list))
+    {
+        __position = FWL32_move_after(__list, __position, __src_list, FWL32_BEFORE_BEGIN);
+    }
+    FWL32_clear(__src_list);
+}
+
+void FWL32_splice_after_element(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list,
+                                                                                   FWL32_iterator __i)
+{
+    if(__position == FWL32_NIL || __i == FWL32_NIL || FWL32_empty(__src_list) || FWL32_link(__src_list, __i) == FWL32_NIL)
+    {
+        return;
+    }
+    if(__list == __src_list && (__position == __i || __position == FWL32_link(__list, __i)))
+    {
+        return;
+    }
+    FWL32_move_after(__list, __position, __src_list, __i);
+}
+
+void FWL32_splice_after_range(Forward_List32* __list, FWL32_iterator __position, Forward_List32* __src_list,
+                                                      FWL32_iterator __before, FWL32_iterator __last)
+{
+    if(FWL32_empty(__src_list) || __before == FWL32_NIL || __before == __last || FWL32_link(__src_list, __before) == __last)
+    {
+        return;
+    }
+    if(__list != __src_list)
+    {
+        while(FWL32_link(__src_list, __before) != __last)
+        {
+            __position = FWL32_move_after(__list, __position, __src_list, __before);
+        }
+        return;
+    }
+    /* Within one list the range is relinked as a whole. */
+    FWL32_iterator __first = FWL32_link(__list, __before);
+    FWL32_iterator __tail = __first;
+    while(FWL32_link(__list, __tail) != __last)
+    {
+        __tail = FWL32_link(__list, __tail);
+    }
+    FWL32_link(__list, __before) = __last;
+    if(__last == FWL32_NIL)
+    {
+        __list->finish = __before == FWL32_BEFORE_BEGIN ? FWL32_NIL : __before;
+    }
+    FWL32_link(__list, __tail) = FWL32_link(__list, __position);
+    FWL32_link(__list, __position) = __first;
+    if(FWL32_link(__list, __tail) == FWL32_NIL)
+    {
+        __list->finish = __tail;
+    }
+}
+
+int FWL32_empty(Forward_List32* __list)
+{
+    return __list->count == 0;
+}
+
+size_t FWL32_size(Forward_List32* __list)
+{
+    return __list->count;
+}
+
+/* Stable merge of two FWL32_NIL terminated chains. */
+static FWL32_iterator FWL32_merge(Forward_List32* __list, FWL32_iterator __a, FWL32_iterator __b,
+                                  int (*__compare)(const void *, const void *))
+{
+    FWL32_iterator __head = FWL32_BEFORE_BEGIN;
+    FWL32_iterator __saved = FWL32_link(__list, __head);
+    FWL32_iterator __tail = __head;
+    while(__a != FWL32_NIL && __b != FWL32_NIL)
+    {
+        if(__compare(FWL32_storage(__list, __a), FWL32_storage(__list, __b)))
+        {
+            FWL32_link(__list, __tail) = __b;
+            __tail = __b;
+            __b = FWL32_link(__list, __b);
+        }
+        else
+        {
+            FWL32_link(__list, __tail) = __a;
+            __tail = __a;
+            __a = FWL32_link(__list, __a);
+        }
+    }
+    FWL32_link(__list, __tail) = __a != FWL32_NIL ? __a : __b;
+    FWL32_iterator __ret = FWL32_link(__list, __head);
+    FWL32_link(__list, __head) = __saved;
+    return __ret;
+}
+
+void FWL32_sort(Forward_List32* __list, int (*__compare)(const void *, const void *))
+{
+    if(__list->count < 2 || !__compare)
+    {
+        return;
+    }
+    /* Bottom-up merge sort, __bins[k] holds a sorted chain of 2^k nodes. */
+    FWL32_iterator __bins[64];
+    size_t __used = 0;
+    FWL32_iterator __it = FWL32_begin(__list);
+    while(__it != FWL32_NIL)
+    {
+        FWL32_iterator __chain = __it;
+        __it = FWL32_link(__list, __it);
+        FWL32_link(__list, __chain) = FWL32_NIL;
+        size_t __k = 0;
+        for (; __k < __used && __bins[__k] != FWL32_NIL; ++__k)
+        {
+            __chain = FWL32_merge(__list, __bins[__k], __chain, __compare);
+            __bins[__k] = FWL32_NIL;
+        }
+        if(__k == __used)
+        {
+            ++__used;
+        }
+        __bins[__k] = __chain;
+    }
+    FWL32_iterator __result = FWL32_NIL;
+    for (size_t __k = 0; __k < __used; ++__k)
+    {
+        if(__bins[__k] != FWL32_NIL)
+        {
+            __result = __result == FWL32_NIL ? __bins[__k] : FWL32_merge(__list, __bins[__k], __result, __compare);
+        }
+    }
+    FWL32_link(__list, FWL32_BEFORE_BEGIN) = __result;
+    while(FWL32_link(__list, __result) != FWL32_NIL)
+    {
+        __result = FWL32_link(__list, __result);
+    }
+    __list->finish = __result;
+}
+
+void FWL32_reverse(Forward_List32* __list)
+{
+    if(__list->count < 2)
+    {
+        return;
+    }
+    FWL32_iterator __current = FWL32_begin(__list);
+    FWL32_iterator __prev = FWL32_NIL;
+    FWL32_iterator __next = FWL32_NIL;
+    __list->finish = __current;
+    while(__current != FWL32_NIL)
+    {
+        __next = FWL32_link(__list, __current);
+        FWL32_link(__list, __current) = __prev;
+        __prev = __current;
+        __current = __next;
+    }
+    FWL32_link(__list, FWL32_BEFORE_BEGIN) = __prev;
+}
+
+void FWL32_clear(Forward_List32* __list)
+{
+    free(__list->nodes);
+    __list->nodes = NULL;
+    __list->capacity = 0;
+    __list->used = 0;
+    __list->free_nodes = FWL32_NIL;
+    __list->finish = FWL32_NIL;
+    __list->count = 0;
+}
+
+Forward_List32 FWL32_Init(size_t __size)
+{
+    /* Small elements share the 4 byte word of the link, wider ones get their alignment. */
+    size_t __align = __size & -__size;
+    if(__align < sizeof(uint32_t))
+    {
+        __align = sizeof(uint32_t);
+    }
+    if(__align > _Alignof(Forward_List_Node))
+    {
+        __align = _Alignof(Forward_List_Node);
+    }
+    size_t __offset = __align;
+    size_t __stride = (__offset + __size + __align - 1) / __align * __align;
+    Forward_List32 temp = {.nodes = NULL, .capacity = 0, .used = 0,
+                           .free_nodes = FWL32_NIL, .finish = FWL32_NIL,
+                           .count = 0, .size = __size,
+                           .stride = __stride, .offset = __offset};
+    return temp;
+}
@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/forward_list_atomic.h"
+#include "../include/forward_list_epoch.h"
+
+void FWLA_Init(Forward_List_Atomic* __list, size_t __size)
+{
+    atomic_init(&__list->start, NULL);
+    atomic_init(&__list->count, 0);
+    __list->size = __size;
+}
+
+/* Links the chain __first..__last of __n nodes in front with one CAS. */
+static void FWLA_publish(Forward_List_Atomic* __list, Forward_List_Node* __first, Forward_List_Node* __last, size_t __n)
+{
+    /* Counted first, so that a concurrent pop never takes the count below zero. */
+    atomic_fetch_add_explicit(&__list->count, __n, memory_order_relaxed);
+    Forward_List_Node* __head = atomic_load_explicit(&__list->start, memory_order_relaxed);
+    do
+    {
+        __last->next = __head;
+    }
+    while(!atomic_compare_exchange_weak_explicit(&__list->start, &__head, __first,
+                                                 memory_order_release, memory_order_relaxed));
+}
+
+void _FWLA_push_front(Forward_List_Atomic* __list, const void* __value)
+{
+    Forward_List_Node* __node = (Forward_List_Node*) malloc(sizeof(Forward_List_Node) + __list->size);
+    if(!__node)
+    {
+        printf("%s : Out of memory\n", "FWLA_push_front()");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(__node->storage, __value, __list->size);
+    FWLA_publish(__list, __node, __node, 1);
+}
+
+void FWLA_push_list(Forward_List_Atomic* __list, Forward_List* __src_list)
+{
+    if(FWL_empty(__src_list))
+    {
+        return;
+    }
+    if(__src_list->allocator != FWL_ALLOC_HEAP || __src_list->size != __list->size)
+    {
+        printf("%s", "FWLA_push_list(): only heap lists of the same element size can be pushed\n");
+        exit(EXIT_FAILURE);
+    }
+    Forward_List_Node* __first = __src_list->start;
+    Forward_List_Node* __last = __src_list->finish;
+    size_t __n = __src_list->count;
+    /* The nodes now belong to __list, clearing only drops the indexes of the source. */
+    __src_list->start = NULL;
+    __src_list->finish = NULL;
+    __src_list->count = 0;
+    FWL_clear(__src_list);
+    FWLA_publish(__list, __first, __last, __n);
+}
+
+int FWLA_pop_front(Forward_List_Atomic* __list, void* __out)
+{
+    FWL_epoch_enter();
+    Forward_List_Node* __head = atomic_load_explicit(&__list->start, memory_order_acquire);
+    while(__head && !atomic_compare_exchange_weak_explicit(&__list->start, &__head, __head->next,
+                                                           memory_order_acquire, memory_order_acquire))
+    {
+    }
+    FWL_epoch_exit();
+    if(!__head)
+    {
+        return 0;
+    }
+    atomic_fetch_sub_explicit(&__list->count, 1, memory_order_relaxed);
+    if(__out)
+    {
+        memcpy(__out, __head->storage, __list->size);
+    }
+    FWL_epoch_retire(__head, free);
+    return 1;
+}
+
+Forward_List FWLA_take_all(Forward_List_Atomic* __list)
+{
+    Forward_List __result = FWL_Init(__list->size);
+    Forward_List_Node* __first = atomic_exchange_explicit(&__list->start, NULL, memory_order_acquire);
+    if(!__first)
+    {
+        return __result;
+    }
+    /* Pops that loaded __first before the exchange may still read its link. */
+    FWL_epoch_synchronize();
+    size_t __n = 1;
+    Forward_List_Node* __last = __first;
+    for (; __last->next; __last = __last->next)
+    {
+        ++__n;
+    }
+    atomic_fetch_sub_explicit(&__list->count, __n, memory_order_relaxed);
+    __result.start = __first;
+    __result.finish = __last;
+    __result.count = __n;
+    return __result;
+}
+
+int FWLA_empty(Forward_List_Atomic* __list)
+{
+    return atomic_load_explicit(&__list->start, memory_order_relaxed) == NULL;
+}
+
+size_t FWLA_size(Forward_List_Atomic* __list)
+{
+    return atomic_load_explicit(&__list->count, memory_order_relaxed);
+}
+
+void FWLA_clear(Forward_List_Atomic* __list)
+{
+    Forward_List __all = FWLA_take_all(__list);
+    FWL_clear(&__all);
+}
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include "../include/forward_list_epoch.h"
+
+/* Retirements between two attempts to advance the global epoch. */
+#define FWL_EPOCH_BATCH 64
+
+/*
+ * Classic three epoch scheme. A thread in a critical section announces
+ * the global epoch it saw, and the global epoch only moves from e to
+ * e + 1 once every active thread announces e. Memory retired while the
+ * global epoch was e is therefore unreachable once it reaches e + 2.
+ * Each thread keeps one bag of retired memory per epoch modulo 3.
+ */
+struct FWL_Epoch_Item
+{
+    void* ptr;
+    void (*release)(void *);
+};
+
+struct FWL_Epoch_Bag
+{
+    struct FWL_Epoch_Item* items;
+    size_t length;
+    size_t capacity;
+    uint64_t epoch;                 /* Global epoch at which the items were retired. */
+};
+
+struct FWL_Epoch_Record
+{
+    _Atomic uint64_t state;         /* Announced epoch shifted left, low bit set while active. */
+    atomic_int in_use;              /* Owned by a running thread. */
+    struct FWL_Epoch_Record* next;  /* Never changes once the record is published. */
+    size_t nesting;
+    size_t retired;                 /* Retirements since the last advance attempt. */
+    struct FWL_Epoch_Bag bags[3];
+};
+
+static _Atomic uint64_t FWL_epoch_global = 2;
+static _Atomic(struct FWL_Epoch_Record*) FWL_epoch_records;
+static _Thread_local struct FWL_Epoch_Record* FWL_epoch_self;
+static pthread_once_t FWL_epoch_once = PTHREAD_ONCE_INIT;
+static pthread_key_t FWL_epoch_key;
+
+static void FWL_epoch_exit_thread(void* __arg)
+{
+    struct FWL_Epoch_Record* __record = (struct FWL_Epoch_Record*) __arg;
+    __record->nesting = 0;
+    atomic_store(&__record->state, 0);
+    /* What is still retired stays in the bags for the next owner. */
+    atomic_store_explicit(&__record->in_use, 0, memory_order_release);
+}
+
+static void FWL_epoch_make_key(void)
+{
+    pthread_key_create(&FWL_epoch_key, FWL_epoch_exit_thread);
+}
+
+/* Record of the calling thread, reusing the one of an exited thread if possible. */
+static struct FWL_Epoch_Record* FWL_epoch_record(void)
+{
+    struct FWL_Epoch_Record* __record = FWL_epoch_self;
+    if(__record)
+    {
+        return __record;
+    }
+    for (__record = atomic_load(&FWL_epoch_records); __record; __record = __record->next)
+    {
+        int __free = 0;
+        if(atomic_compare_exchange_strong(&__record->in_use, &__free, 1))
+        {
+            break;
+        }
+    }
+    if(!__record)
+    {
+        __record = (struct FWL_Epoch_Record*) calloc(1, sizeof(struct FWL_Epoch_Record));
+        if(!__record)
+        {
+            printf("%s : Out of memory\n", "FWL_epoch_enter()");
+            exit(EXIT_FAILURE);
+        }
+        atomic_init(&__record->in_use, 1);
+        __record->next = atomic_load(&FWL_epoch_records);
+        while(!atomic_compare_exchange_weak(&FWL_epoch_records, &__record->next, __record))
+        {
+        }
+    }
+    pthread_once(&FWL_epoch_once, FWL_epoch_make_key);
+    pthread_setspecific(FWL_epoch_key, __record);
+    FWL_epoch_self = __record;
+    return __record;
+}
+
+void FWL_epoch_enter(void)
+{
+    struct FWL_Epoch_Record* __record = FWL_epoch_record();
+    if(__record->nesting++ == 0)
+    {
+        uint64_t __epoch = atomic_load(&FWL_epoch_global);
+        atomic_store(&__record->state, (__epoch << 1) | 1);
+        atomic_thread_fence(memory_order_seq_cst);
+    }
+}
+
+void FWL_epoch_exit(void)
+{
+    struct FWL_Epoch_Record* __record = FWL_epoch_self;
+    if(__record && __record->nesting && --__record->nesting == 0)
+    {
+        atomic_store_explicit(&__record->state, 0, memory_order_release);
+    }
+}
+
+/* Moves the global epoch forward if every active thread has caught up with it. */
+static void FWL_epoch_try_advance(void)
+{
+    uint64_t __epoch = atomic_load(&FWL_epoch_global);
+    for (struct FWL_Epoch_Record* __it = atomic_load(&FWL_epoch_records); __it; __it = __it->next)
+    {
+        uint64_t __state = atomic_load(&__it->state);
+        if((__state & 1) && (__state >> 1) != __epoch)
+        {
+            return;
+        }
+    }
+    atomic_compare_exchange_strong(&FWL_epoch_global, &__epoch, __epoch + 1);
+}
+
+static void FWL_epoch_release_bag(struct FWL_Epoch_Bag* __bag)
+{
+    for (size_t __i = 0; __i < __bag->length; ++__i)
+    {
+        __bag->items[__i].release(__bag->items[__i].ptr);
+    }
+    __bag->length = 0;
+}
+
+/* Releases the bags whose grace period is over. */
+static void FWL_epoch_collect(struct FWL_Epoch_Record* __record)
+{
+    uint64_t __epoch = atomic_load(&FWL_epoch_global);
+    for (int __i = 0; __i < 3; ++__i)
+    {
+        struct FWL_Epoch_Bag* __bag = __record->bags + __i;
+        if(__bag->length && __bag->epoch + 2 <= __epoch)
+        {
+            FWL_epoch_release_bag(__bag);
+        }
+    }
+}
+
+void FWL_epoch_retire(void* __ptr, void (*__release)(void *))
+{
+    struct FWL_Epoch_Record* __record = FWL_epoch_record();
+    uint64_t __epoch = atomic_load(&FWL_epoch_global);
+    struct FWL_Epoch_Bag* __bag = __record->bags + __epoch % 3;
+    if(__bag->epoch != __epoch)
+    {
+        /* The bag holds items at least three epochs old. */
+        FWL_epoch_release_bag(__bag);
+        __bag->epoch = __epoch;
+    }
+    if(__bag->length == __bag->capacity)
+    {
+        size_t __capacity = __bag->capacity ? 2 * __bag->capacity : FWL_EPOCH_BATCH;
+        struct FWL_Epoch_Item* __items = (struct FWL_Epoch_Item*) realloc(__bag->items,
+                                                                          __capacity * sizeof(struct FWL_Epoch_Item));
+        if(!__items)
+        {
+            printf("%s : Out of memory\n", "FWL_epoch_retire()");
+            exit(EXIT_FAILURE);
+        }
+        __bag->items = __items;
+        __bag->capacity = __capacity;
+    }
+    __bag->items[__bag->length].ptr = __ptr;
+    __bag->items[__bag->length].release = __release;
+    ++__bag->length;
+    if(++__record->retired >= FWL_EPOCH_BATCH)
+    {
+        __record->retired = 0;
+        FWL_epoch_try_advance();
+        FWL_epoch_collect(__record);
+    }
+}
+
+void FWL_epoch_synchronize(void)
+{
+    uint64_t __target = atomic_load(&FWL_epoch_global) + 2;
+    for (;;)
+    {
+        FWL_epoch_try_advance();
+        if(atomic_load(&FWL_epoch_global) >= __target)
+        {
+            return;
+        }
+        sched_yield();
+    }
+}
+
+void FWL_epoch_flush(void)
+{
+    struct FWL_Epoch_Record* __record = FWL_epoch_record();
+    FWL_epoch_synchronize();
+    for (int __i = 0; __i < 3; ++__i)
+    {
+        FWL_epoch_release_bag(__record->bags + __i);
+    }
+    __record->retired = 0;
+}
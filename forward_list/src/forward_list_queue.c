@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/forward_list_queue.h"
+
+/*
+ * The consumer owns tail, a node already consumed whose next link holds
+ * the first element. Producers exchange head with their node and only
+ * then link the previous head to it, so each node is linked exactly once
+ * and the consumer sees a prefix of the pushes.
+ */
+#define FWLQ_load(__node)            __atomic_load_n(&(__node)->next, __ATOMIC_ACQUIRE)
+#define FWLQ_publish(__node, __next) __atomic_store_n(&(__node)->next, __next, __ATOMIC_RELEASE)
+
+static Forward_List_Node* FWLQ_new_node(Forward_List_Queue* __queue, const char* __func)
+{
+    Forward_List_Node* __node = (Forward_List_Node*) malloc(sizeof(Forward_List_Node) + __queue->size);
+    if(!__node)
+    {
+        printf("%s : Out of memory\n", __func);
+        exit(EXIT_FAILURE);
+    }
+    atomic_fetch_add_explicit(&__queue->nodes, 1, memory_order_relaxed);
+    return __node;
+}
+
+static void FWLQ_free_chain(Forward_List_Node* __it)
+{
+    while(__it)
+    {
+        Forward_List_Node* __next = __it->next;
+        free(__it);
+        __it = __next;
+    }
+}
+
+void FWLQ_Init(Forward_List_Queue* __queue, size_t __size, size_t __capacity)
+{
+    __queue->size = __size;
+    __queue->capacity = __capacity;
+    atomic_init(&__queue->count, 0);
+    atomic_init(&__queue->nodes, 0);
+    atomic_init(&__queue->recycled, NULL);
+    atomic_flag_clear(&__queue->cache_lock);
+    __queue->cache = NULL;
+    Forward_List_Node* __stub = FWLQ_new_node(__queue, "FWLQ_Init()");
+    __stub->next = NULL;
+    __queue->tail = __stub;
+    atomic_init(&__queue->head, __stub);
+}
+
+void FWLQ_Destroy(Forward_List_Queue* __queue)
+{
+    FWLQ_free_chain(__queue->tail);
+    FWLQ_free_chain(__queue->cache);
+    FWLQ_free_chain(atomic_load(&__queue->recycled));
+    __queue->tail = NULL;
+    __queue->cache = NULL;
+    atomic_store(&__queue->head, NULL);
+    atomic_store(&__queue->recycled, NULL);
+    atomic_store(&__queue->count, 0);
+    atomic_store(&__queue->nodes, 0);
+}
+
+/* Reserves room for __n elements, all or nothing. */
+static int FWLQ_reserve(Forward_List_Queue* __queue, size_t __n)
+{
+    size_t __count = atomic_load_explicit(&__queue->count, memory_order_relaxed);
+    do
+    {
+        if(__n > __queue->capacity - __count)
+        {
+            return 0;
+        }
+    }
+    while(!atomic_compare_exchange_weak_explicit(&__queue->count, &__count, __count + __n,
+                                                 memory_order_relaxed, memory_order_relaxed));
+    return 1;
+}
+
+/*
+ * A recycled node if one is at hand, a new one otherwise. A producer
+ * that finds the cache busy allocates instead of waiting for it.
+ */
+static Forward_List_Node* FWLQ_get_node(Forward_List_Queue* __queue)
+{
+    Forward_List_Node* __node = NULL;
+    if(!atomic_flag_test_and_set_explicit(&__queue->cache_lock, memory_order_acquire))
+    {
+        __node = __queue->cache;
+        if(!__node)
+        {
+            __node = atomic_exchange_explicit(&__queue->recycled, NULL, memory_order_acquire);
+        }
+        if(__node)
+        {
+            __queue->cache = __node->next;
+        }
+        atomic_flag_clear_explicit(&__queue->cache_lock, memory_order_release);
+    }
+    return __node ? __node : FWLQ_new_node(__queue, "FWLQ_push()");
+}
+
+/* Gives a consumed node back to the producers, or frees it if enough are kept. */
+static void FWLQ_recycle(Forward_List_Queue* __queue, Forward_List_Node* __node)
+{
+    if(atomic_load_explicit(&__queue->nodes, memory_order_relaxed) > __queue->capacity + 1)
+    {
+        atomic_fetch_sub_explicit(&__queue->nodes, 1, memory_order_relaxed);
+        free(__node);
+        return;
+    }
+    Forward_List_Node* __top = atomic_load_explicit(&__queue->recycled, memory_order_relaxed);
+    do
+    {
+        __node->next = __top;
+    }
+    while(!atomic_compare_exchange_weak_explicit(&__queue->recycled, &__top, __node,
+                                                 memory_order_release, memory_order_relaxed));
+}
+
+/* Links the chain __first..__last at the end. */
+static void FWLQ_link(Forward_List_Queue* __queue, Forward_List_Node* __first, Forward_List_Node* __last)
+{
+    __last->next = NULL;
+    Forward_List_Node* __prev = atomic_exchange_explicit(&__queue->head, __last, memory_order_acq_rel);
+    FWLQ_publish(__prev, __first);
+}
+
+int _FWLQ_push(Forward_List_Queue* __queue, const void* __value)
+{
+    if(!FWLQ_reserve(__queue, 1))
+    {
+        return 0;
+    }
+    Forward_List_Node* __node = FWLQ_get_node(__queue);
+    memcpy(__node->storage, __value, __queue->size);
+    FWLQ_link(__queue, __node, __node);
+    return 1;
+}
+
+int FWLQ_push_list(Forward_List_Queue* __queue, Forward_List* __src_list)
+{
+    if(FWL_empty(__src_list))
+    {
+        return 1;
+    }
+    if(__src_list->allocator != FWL_ALLOC_HEAP || __src_list->size != __queue->size)
+    {
+        printf("%s", "FWLQ_push_list(): only heap lists of the same element size can be pushed\n");
+        exit(EXIT_FAILURE);
+    }
+    size_t __n = __src_list->count;
+    if(!FWLQ_reserve(__queue, __n))
+    {
+        return 0;
+    }
+    Forward_List_Node* __first = __src_list->start;
+    Forward_List_Node* __last = __src_list->finish;
+    /* The nodes now belong to the queue, clearing only drops the indexes of the source. */
+    __src_list->start = NULL;
+    __src_list->finish = NULL;
+    __src_list->count = 0;
+    FWL_clear(__src_list);
+    atomic_fetch_add_explicit(&__queue->nodes, __n, memory_order_relaxed);
+    FWLQ_link(__queue, __first, __last);
+    return 1;
+}
+
+int FWLQ_pop(Forward_List_Queue* __queue, void* __out)
+{
+    Forward_List_Node* __consumed = __queue->tail;
+    Forward_List_Node* __next = FWLQ_load(__consumed);
+    if(!__next)
+    {
+        return 0;
+    }
+    if(__out)
+    {
+        memcpy(__out, __next->storage, __queue->size);
+    }
+    __queue->tail = __next;
+    atomic_fetch_sub_explicit(&__queue->count, 1, memory_order_relaxed);
+    FWLQ_recycle(__queue, __consumed);
+    return 1;
+}
+
+size_t FWLQ_pop_list(Forward_List_Queue* __queue, Forward_List* __list, size_t __max)
+{
+    if(__list->allocator != FWL_ALLOC_HEAP || __list->size != __queue->size)
+    {
+        printf("%s", "FWLQ_pop_list(): only heap lists of the same element size can receive\n");
+        exit(EXIT_FAILURE);
+    }
+    /*
+     * The last element consumed has to stay as the new tail, so every
+     * element moves one node back and the chain starting at the old tail
+     * is handed over.
+     */
+    Forward_List_Node* __first = __queue->tail;
+    Forward_List_Node* __last = NULL;
+    Forward_List_Node* __it = __first;
+    size_t __n = 0;
+    for (Forward_List_Node* __next; __n < __max && (__next = FWLQ_load(__it)); __it = __next, ++__n)
+    {
+        memcpy(__it->storage, __next->storage, __queue->size);
+        __last = __it;
+    }
+    if(!__n)
+    {
+        return 0;
+    }
+    __queue->tail = __it;
+    __last->next = NULL;
+    atomic_fetch_sub_explicit(&__queue->count, __n, memory_order_relaxed);
+    atomic_fetch_sub_explicit(&__queue->nodes, __n, memory_order_relaxed);
+
+    Forward_List __chain = FWL_Init(__queue->size);
+    __chain.start = __first;
+    __chain.finish = __last;
+    __chain.count = __n;
+    FWL_splice_after_list(__list, __list->finish ? __list->finish : FWL_before_begin(__list), &__chain);
+    return __n;
+}
+
+size_t FWLQ_size(Forward_List_Queue* __queue)
+{
+    return atomic_load_explicit(&__queue->count, memory_order_relaxed);
+}
+
+int FWLQ_empty(Forward_List_Queue* __queue)
+{
+    return FWLQ_load(__queue->tail) == NULL;
+}
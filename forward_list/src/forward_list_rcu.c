@@ -0,0 +1,224 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/forward_list_rcu.h"
+#include "../include/forward_list_epoch.h"
+
+/*
+ * Readers load links with acquire, writers store them with release once
+ * the node behind is complete. Links are plain Forward_List_Node fields
+ * accessed with the GCC atomic builtins, and the list acts as its own
+ * before-begin node, since start is its first member.
+ */
+#define FWLR_load(__node)            __atomic_load_n(&(__node)->next, __ATOMIC_ACQUIRE)
+#define FWLR_publish(__node, __next) __atomic_store_n(&(__node)->next, __next, __ATOMIC_RELEASE)
+
+void FWLR_Init(Forward_List_RCU* __list, size_t __size)
+{
+    __list->start = NULL;
+    __list->finish = NULL;
+    __list->count = 0;
+    __list->size = __size;
+    pthread_mutex_init(&__list->lock, NULL);
+}
+
+void FWLR_Destroy(Forward_List_RCU* __list)
+{
+    Forward_List_Node* __it = __list->start;
+    while(__it)
+    {
+        Forward_List_Node* __next = __it->next;
+        free(__it);
+        __it = __next;
+    }
+    __list->start = NULL;
+    __list->finish = NULL;
+    __list->count = 0;
+    pthread_mutex_destroy(&__list->lock);
+}
+
+void FWLR_read_lock(void)
+{
+    FWL_epoch_enter();
+}
+
+void FWLR_read_unlock(void)
+{
+    FWL_epoch_exit();
+}
+
+FWL_iterator FWLR_begin(Forward_List_RCU* __list)
+{
+    return __atomic_load_n(&__list->start, __ATOMIC_ACQUIRE);
+}
+
+FWL_iterator FWLR_next(FWL_iterator __current)
+{
+    return FWLR_load(__current);
+}
+
+void FWLR_write_lock(Forward_List_RCU* __list)
+{
+    pthread_mutex_lock(&__list->lock);
+}
+
+void FWLR_write_unlock(Forward_List_RCU* __list)
+{
+    pthread_mutex_unlock(&__list->lock);
+}
+
+FWL_iterator FWLR_before_begin(Forward_List_RCU* __list)
+{
+    return (FWL_iterator) &__list->start;
+}
+
+static void FWLR_set_count(Forward_List_RCU* __list, size_t __count)
+{
+    __atomic_store_n(&__list->count, __count, __ATOMIC_RELAXED);
+}
+
+static Forward_List_Node* FWLR_new_node(Forward_List_RCU* __list, const void* __value, const char* __func)
+{
+    Forward_List_Node* __node = (Forward_List_Node*) malloc(sizeof(Forward_List_Node) + __list->size);
+    if(!__node)
+    {
+        printf("%s : Out of memory\n", __func);
+        exit(EXIT_FAILURE);
+    }
+    memcpy(__node->storage, __value, __list->size);
+    return __node;
+}
+
+FWL_iterator _FWLR_insert_after(Forward_List_RCU* __list, FWL_iterator __position, const void* __value)
+{
+    Forward_List_Node* __node = FWLR_new_node(__list, __value, "FWLR_insert_after()");
+    __node->next = __position->next;
+    FWLR_publish(__position, __node);
+    if(!__node->next)
+    {
+        __list->finish = __node;
+    }
+    FWLR_set_count(__list, __list->count + 1);
+    return __node;
+}
+
+FWL_iterator _FWLR_replace_after(Forward_List_RCU* __list, FWL_iterator __position, const void* __value)
+{
+    Forward_List_Node* __old = __position->next;
+    if(!__old)
+    {
+        printf("%s", "FWLR_replace_after(): no element after the position\n");
+        exit(EXIT_FAILURE);
+    }
+    Forward_List_Node* __node = FWLR_new_node(__list, __value, "FWLR_replace_after()");
+    __node->next = __old->next;
+    FWLR_publish(__position, __node);
+    if(__list->finish == __old)
+    {
+        __list->finish = __node;
+    }
+    FWL_epoch_retire(__old, free);
+    return __node;
+}
+
+FWL_iterator FWLR_erase_after(Forward_List_RCU* __list, FWL_iterator __position)
+{
+    Forward_List_Node* __old = __position->next;
+    if(!__old)
+    {
+        printf("%s", "FWLR_erase_after(): no element after the position\n");
+        exit(EXIT_FAILURE);
+    }
+    /* The erased node keeps its link for the readers standing on it. */
+    FWLR_publish(__position, __old->next);
+    if(__list->finish == __old)
+    {
+        __list->finish = __position == FWLR_before_begin(__list) ? NULL : __position;
+    }
+    FWLR_set_count(__list, __list->count - 1);
+    FWL_epoch_retire(__old, free);
+    return __position->next;
+}
+
+void _FWLR_push_front(Forward_List_RCU* __list, const void* __value)
+{
+    FWLR_write_lock(__list);
+    _FWLR_insert_after(__list, FWLR_before_begin(__list), __value);
+    FWLR_write_unlock(__list);
+}
+
+void _FWLR_push_back(Forward_List_RCU* __list, const void* __value)
+{
+    FWLR_write_lock(__list);
+    FWL_iterator __last = __list->finish ? __list->finish : FWLR_before_begin(__list);
+    _FWLR_insert_after(__list, __last, __value);
+    FWLR_write_unlock(__list);
+}
+
+size_t FWLR_remove_if(Forward_List_RCU* __list, int (*__predicate)(const void *))
+{
+    size_t __removed = 0;
+    FWLR_write_lock(__list);
+    FWL_iterator __before = FWLR_before_begin(__list);
+    while(__before->next)
+    {
+        if(__predicate(__before->next->storage))
+        {
+            FWLR_erase_after(__list, __before);
+            ++__removed;
+        }
+        else
+        {
+            __before = __before->next;
+        }
+    }
+    FWLR_write_unlock(__list);
+    return __removed;
+}
+
+void FWLR_splice_back(Forward_List_RCU* __list, Forward_List* __src_list)
+{
+    if(FWL_empty(__src_list))
+    {
+        return;
+    }
+    if(__src_list->allocator != FWL_ALLOC_HEAP || __src_list->size != __list->size)
+    {
+        printf("%s", "FWLR_splice_back(): only heap lists of the same element size can be spliced\n");
+        exit(EXIT_FAILURE);
+    }
+    Forward_List_Node* __first = __src_list->start;
+    Forward_List_Node* __last = __src_list->finish;
+    size_t __n = __src_list->count;
+    /* The nodes now belong to __list, clearing only drops the indexes of the source. */
+    __src_list->start = NULL;
+    __src_list->finish = NULL;
+    __src_list->count = 0;
+    FWL_clear(__src_list);
+    FWLR_write_lock(__list);
+    FWLR_publish(__list->finish ? __list->finish : FWLR_before_begin(__list), __first);
+    __list->finish = __last;
+    FWLR_set_count(__list, __list->count + __n);
+    FWLR_write_unlock(__list);
+}
+
+size_t FWLR_size(Forward_List_RCU* __list)
+{
+    return __atomic_load_n(&__list->count, __ATOMIC_RELAXED);
+}
+
+void FWLR_clear(Forward_List_RCU* __list)
+{
+    FWLR_write_lock(__list);
+    Forward_List_Node* __it = __list->start;
+    FWLR_publish(FWLR_before_begin(__list), NULL);
+    __list->finish = NULL;
+    FWLR_set_count(__list, 0);
+    FWLR_write_unlock(__list);
+    while(__it)
+    {
+        Forward_List_Node* __next = __it->next;
+        FWL_epoch_retire(__it, free);
+        __it = __next;
+    }
+}
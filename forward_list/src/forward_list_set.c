@@ -0,0 +1,185 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "../include/forward_list_set.h"
+#include "../include/forward_list_epoch.h"
+
+/*
+ * The next link of a node doubles as its deletion mark, in its low bit.
+ * Links are plain Forward_List_Node fields accessed with the GCC atomic
+ * builtins. The set itself acts as the before-begin node, since start
+ * is its first member.
+ */
+#define FWLS_MARK ((uintptr_t) 1)
+
+#define FWLS_load(__node)     ((uintptr_t) __atomic_load_n(&(__node)->next, __ATOMIC_ACQUIRE))
+#define FWLS_ptr(__link)      ((Forward_List_Node*) ((__link) & ~FWLS_MARK))
+#define FWLS_marked(__link)   ((__link) & FWLS_MARK)
+
+static Forward_List_Node* FWLS_head(Forward_List_Set* __set)
+{
+    return (Forward_List_Node*) &__set->start;
+}
+
+static int FWLS_cas(Forward_List_Node* __node, uintptr_t __expected, uintptr_t __desired)
+{
+    Forward_List_Node* __old = (Forward_List_Node*) __expected;
+    return __atomic_compare_exchange_n(&__node->next, &__old, (Forward_List_Node*) __desired, 0,
+                                       __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+void FWLS_Init(Forward_List_Set* __set, size_t __size, int (*__compare)(const void *, const void *))
+{
+    __set->start = NULL;
+    atomic_init(&__set->count, 0);
+    __set->size = __size;
+    __set->compare = __compare;
+}
+
+/*
+ * Finds the first node not less than __value and its predecessor,
+ * unlinking the marked nodes met on the way. Must be called inside an
+ * epoch critical section.
+ */
+static Forward_List_Node* FWLS_find(Forward_List_Set* __set, const void* __value, Forward_List_Node** __pred)
+{
+restart:
+    *__pred = FWLS_head(__set);
+    Forward_List_Node* __curr = FWLS_ptr(FWLS_load(*__pred));
+    while(__curr)
+    {
+        uintptr_t __succ = FWLS_load(__curr);
+        if(FWLS_marked(__succ))
+        {
+            if(!FWLS_cas(*__pred, (uintptr_t) __curr, (uintptr_t) FWLS_ptr(__succ)))
+            {
+                goto restart;
+            }
+            FWL_epoch_retire(__curr, free);
+            __curr = FWLS_ptr(__succ);
+            continue;
+        }
+        if(!__set->compare(__value, __curr->storage))
+        {
+            break;
+        }
+        *__pred = __curr;
+        __curr = FWLS_ptr(__succ);
+    }
+    return __curr;
+}
+
+/* True if the node holds a value equal to __value, knowing it is not less. */
+static int FWLS_equal(Forward_List_Set* __set, Forward_List_Node* __node, const void* __value)
+{
+    return __node && !__set->compare(__node->storage, __value);
+}
+
+int _FWLS_insert(Forward_List_Set* __set, const void* __value)
+{
+    Forward_List_Node* __node = NULL;
+    Forward_List_Node* __pred = NULL;
+    int __inserted = 0;
+    FWL_epoch_enter();
+    for (;;)
+    {
+        Forward_List_Node* __curr = FWLS_find(__set, __value, &__pred);
+        if(FWLS_equal(__set, __curr, __value))
+        {
+            break;
+        }
+        if(!__node)
+        {
+            __node = (Forward_List_Node*) malloc(sizeof(Forward_List_Node) + __set->size);
+            if(!__node)
+            {
+                printf("%s : Out of memory\n", "FWLS_insert()");
+                exit(EXIT_FAILURE);
+            }
+            memcpy(__node->storage, __value, __set->size);
+        }
+        __node->next = __curr;
+        if(FWLS_cas(__pred, (uintptr_t) __curr, (uintptr_t) __node))
+        {
+            atomic_fetch_add_explicit(&__set->count, 1, memory_order_relaxed);
+            __inserted = 1;
+            break;
+        }
+    }
+    FWL_epoch_exit();
+    if(!__inserted)
+    {
+        free(__node);
+    }
+    return __inserted;
+}
+
+int _FWLS_erase(Forward_List_Set* __set, const void* __value)
+{
+    Forward_List_Node* __pred = NULL;
+    int __erased = 0;
+    FWL_epoch_enter();
+    for (;;)
+    {
+        Forward_List_Node* __curr = FWLS_find(__set, __value, &__pred);
+        if(!FWLS_equal(__set, __curr, __value))
+        {
+            break;
+        }
+        uintptr_t __succ = FWLS_load(__curr);
+        if(FWLS_marked(__succ) || !FWLS_cas(__curr, __succ, __succ | FWLS_MARK))
+        {
+            continue;
+        }
+        /* Logically erased, unlink it now or leave it to the next traversal. */
+        atomic_fetch_sub_explicit(&__set->count, 1, memory_order_relaxed);
+        __erased = 1;
+        if(FWLS_cas(__pred, (uintptr_t) __curr, __succ))
+        {
+            FWL_epoch_retire(__curr, free);
+        }
+        else
+        {
+            FWLS_find(__set, __value, &__pred);
+        }
+        break;
+    }
+    FWL_epoch_exit();
+    return __erased;
+}
+
+int _FWLS_contains(Forward_List_Set* __set, const void* __value)
+{
+    FWL_epoch_enter();
+    Forward_List_Node* __curr = FWLS_ptr(FWLS_load(FWLS_head(__set)));
+    while(__curr && __set->compare(__value, __curr->storage))
+    {
+        __curr = FWLS_ptr(FWLS_load(__curr));
+    }
+    int __found = FWLS_equal(__set, __curr, __value) && !FWLS_marked(FWLS_load(__curr));
+    FWL_epoch_exit();
+    return __found;
+}
+
+size_t FWLS_size(Forward_List_Set* __set)
+{
+    return atomic_load_explicit(&__set->count, memory_order_relaxed);
+}
+
+int FWLS_empty(Forward_List_Set* __set)
+{
+    return FWLS_size(__set) == 0;
+}
+
+void FWLS_clear(Forward_List_Set* __set)
+{
+    Forward_List_Node* __it = __atomic_exchange_n(&__set->start, NULL, __ATOMIC_ACQ_REL);
+    while(__it)
+    {
+        Forward_List_Node* __next = FWLS_ptr((uintptr_t) __it->next);
+        FWL_epoch_retire(__it, free);
+        __it = __next;
+    }
+    atomic_store_explicit(&__set->count, 0, memory_order_relaxed);
+}
@@ -0,0 +1,478 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../include/forward_list_unrolled.h"
+
+/* Target size of one node, two cache lines. */
+#define FWLU_NODE_BYTES 128
+
+static void FWLU_exit(const char* __func_name, const char* __reason)
+{
+    printf("%s : %s\n", __func_name, __reason);
+    exit(EXIT_FAILURE);
+}
+
+#define FWLU_element(__list, __node, __i) ((__node)->storage + (__i) * (__list)->size)
+
+/* The before-begin iterator points at the list itself, an empty node whose next is start. */
+static Forward_List_Unrolled_Node* FWLU_sentinel(Forward_List_Unrolled* __list)
+{
+    return (Forward_List_Unrolled_Node*) &__list->start;
+}
+
+static Forward_List_Unrolled_Node* FWLU_get_node(Forward_List_Unrolled* __list)
+{
+    Forward_List_Unrolled_Node* __node = (Forward_List_Unrolled_Node*) malloc(sizeof(Forward_List_Unrolled_Node) +
+                                                                              __list->capacity * __list->size);
+    if(!__node)
+    {
+        FWLU_clear(__list);
+        FWLU_exit("FWLU_get_node()", "Out of memory");
+    }
+    __node->next = NULL;
+    __node->used = 0;
+    return __node;
+}
+
+/* Links a node after prev, or at the front if prev is NULL. */
+static void FWLU_link_node(Forward_List_Unrolled* __list, Forward_List_Unrolled_Node* __prev, Forward_List_Unrolled_Node* __node)
+{
+    if(__prev)
+    {
+        __node->next = __prev->next;
+        __prev->next = __node;
+    }
+    else
+    {
+        __node->next = __list->start;
+        __list->start = __node;
+    }
+    if(!__node->next)
+    {
+        __list->finish = __node;
+    }
+}
+
+/* Unlinks and frees a node, prev is its predecessor or NULL. */
+static void FWLU_drop_node(Forward_List_Unrolled* __list, Forward_List_Unrolled_Node* __prev, Forward_List_Unrolled_Node* __node)
+{
+    if(__prev)
+    {
+        __prev->next = __node->next;
+    }
+    else
+    {
+        __list->start = __node->next;
+    }
+    if(__list->finish == __node)
+    {
+        __list->finish = __prev;
+    }
+    free(__node);
+}
+
+/* Moves the elements [keep, used) of a node into a new node linked after it. */
+static Forward_List_Unrolled_Node* FWLU_split(Forward_List_Unrolled* __list, Forward_List_Unrolled_Node* __node, size_t __keep)
+{
+    Forward_List_Unrolled_Node* __tail = FWLU_get_node(__list);
+    __tail->used = __node->used - __keep;
+    memcpy(__tail->storage, FWLU_element(__list, __node, __keep), __tail->used * __list->size);
+    __node->used = __keep;
+    FWLU_link_node(__list, __node, __tail);
+    return __tail;
+}
+
+/* Absorbs the successor of a node when one of them is less than half full and both fit. */
+static int FWLU_merge_next(Forward_List_Unrolled* __list, Forward_List_Unrolled_Node* __node)
+{
+    Forward_List_Unrolled_Node* __next = __node->next;
+    if(!__next || __node->used + __next->used > __list->capacity)
+    {
+        return 0;
+    }
+    if(__node->used >= __list->capacity / 2 && __next->used >= __list->capacity / 2)
+    {
+        return 0;
+    }
+    memcpy(FWLU_element(__list, __node, __node->used), __next->storage, __next->used * __list->size);
+    __node->used += __next->used;
+    FWLU_drop_node(__list, __node, __next);
+    return 1;
+}
+
+FWLU_iterator FWLU_before_begin(Forward_List_Unrolled* __list)
+{
+    FWLU_iterator __it = {.node = FWLU_sentinel(__list), .index = 0};
+    return __it;
+}
+
+FWLU_iterator FWLU_begin(Forward_List_Unrolled* __list)
+{
+    FWLU_iterator __it = {.node = __list->start, .index = 0};
+    return __it;
+}
+
+FWLU_iterator FWLU_rbegin(Forward_List_Unrolled* __list)
+{
+    if(!__list->finish)
+    {
+        return FWLU_before_begin(__list);
+    }
+    FWLU_iterator __it = {.node = __list->finish, .index = __list->finish->used - 1};
+    return __it;
+}
+
+FWLU_iterator _FWLU_insert_after(Forward_List_Unrolled* __list, FWLU_iterator __position, void** __storage)
+{
+    Forward_List_Unrolled_Node* __node = NULL;
+    size_t __idx = 0;
+    if(__position.node == FWLU_sentinel(__list))
+    {
+        __node = __list->start;
+        if(!__node || __node->used == __list->capacity)
+        {
+            __node = FWLU_get_node(__list);
+            FWLU_link_node(__list, NULL, __node);
+        }
+    }
+    else
+    {
+        __node = __position.node;
+        __idx = __position.index + 1;
+        if(__node->used == __list->capacity)
+        {
+            if(__idx == __list->capacity)
+            {
+                /* Appending after a full node, keep filling forward. */
+                if(!__node->next || __node->next->used == __list->capacity)
+                {
+                    FWLU_link_node(__list, __node, FWLU_get_node(__list));
+                }
+                __node = __node->next;
+                __idx = 0;
+            }
+            else
+            {
+                size_t __half = __list->capacity / 2;
+                Forward_List_Unrolled_Node* __tail = FWLU_split(__list, __node, __half);
+                if(__idx > __half)
+                {
+                    __node = __tail;
+                    __idx -= __half;
+                }
+            }
+        }
+    }
+    memmove(FWLU_element(__list, __node, __idx + 1), FWLU_element(__list, __node, __idx),
+            (__node->used - __idx) * __list->size);
+    memset(FWLU_element(__list, __node, __idx), 0, __list->size);
+    ++__node->used;
+    ++__list->count;
+    *__storage = FWLU_element(__list, __node, __idx);
+    FWLU_iterator __it = {.node = __node, .index = __idx};
+    return __it;
+}
+
+FWLU_iterator FWLU_erase_after(Forward_List_Unrolled* __list, FWLU_iterator __before, size_t __n)
+{
+    Forward_List_Unrolled_Node* __prev = NULL;
+    Forward_List_Unrolled_Node* __node = NULL;
+    size_t __idx = 0;
+    if(__before.node == FWLU_sentinel(__list))
+    {
+        __node = __list->start;
+    }
+    else if(__before.index + 1 < __before.node->used)
+    {
+        __node = __before.node;
+        __idx = __before.index + 1;
+    }
+    else
+    {
+        __prev = __before.node;
+        __node = __prev->next;
+    }
+    while(__n && __node)
+    {
+        size_t __k = __node->used - __idx;
+        if(__k > __n)
+        {
+            __k = __n;
+        }
+        memmove(FWLU_element(__list, __node, __idx), FWLU_element(__list, __node, __idx + __k),
+                (__node->used - __idx - __k) * __list->size);
+        __node->used -= __k;
+        __list->count -= __k;
+        __n -= __k;
+        if(!__node->used)
+        {
+            Forward_List_Unrolled_Node* __next = __node->next;
+            FWLU_drop_node(__list, __prev, __node);
+            __node = __next;
+            __idx = 0;
+        }
+        else if(__n)
+        {
+            __prev = __node;
+            __node = __node->next;
+            __idx = 0;
+        }
+    }
+    if(__node)
+    {
+        FWLU_merge_next(__list, __node);
+    }
+    if(__prev && __prev->next == __node)
+    {
+        size_t __offset = __prev->used;
+        if(FWLU_merge_next(__list, __prev))
+        {
+            __node = __prev;
+            __idx += __offset;
+        }
+    }
+    FWLU_iterator __it = {.node = __node, .index = __idx};
+    if(__node && __idx >= __node->used)
+    {
+        __it.node = __node->next;
+        __it.index = 0;
+    }
+    return __it;
+}
+
+FWLU_iterator FWLU_pop_after(Forward_List_Unrolled* __list, FWLU_iterator __position)
+{
+    return FWLU_erase_after(__list, __position, 1);
+}
+
+void FWLU_pop_front(Forward_List_Unrolled* __list)
+{
+    FWLU_erase_after(__list, FWLU_before_begin(__list), 1);
+}
+
+static void FWLU_check_size(Forward_List_Unrolled* __list, Forward_List_Unrolled* __src_list, const char* __func_name)
+{
+    if(__list->size != __src_list->size)
+    {
+        FWLU_exit(__func_name, "element sizes differ");
+    }
+}
+
+void FWLU_splice_after_list(Forward_List_Unrolled* __list, FWLU_iterator __position, Forward_List_Unrolled* __src_list)
+{
+    if(__list == __src_list || FWLU_empty(__src_list))
+    {
+        return;
+    }
+    FWLU_check_size(__list, __src_list, "FWLU_splice_after_list()");
+    Forward_List_Unrolled_Node* __prev = NULL;
+    if(__position.node != FWLU_sentinel(__list))
+    {
+        __prev = __position.node;
+        if(__position.index + 1 < __prev->used)
+        {
+            FWLU_split(__list, __prev, __position.index + 1);
+        }
+    }
+    Forward_List_Unrolled_Node* __last = __src_list->finish;
+    if(__prev)
+    {
+        __last->next = __prev->next;
+        __prev->next = __src_list->start;
+    }
+    else
+    {
+        __last->next = __list->start;
+        __list->start = __src_list->start;
+    }
+    if(!__last->next)
+    {
+        __list->finish = __last;
+    }
+    __list->count += __src_list->count;
+    __src_list->start = NULL;
+    __src_list->finish = NULL;
+    __src_list->count = 0;
+
+    FWLU_merge_next(__list, __last);
+    if(__prev)
+    {
+        FWLU_merge_next(__list, __prev);
+    }
+}
+
+void FWLU_splice_after_range(Forward_List_Unrolled* __list, FWLU_iterator __position, Forward_List_Unrolled* __src_list,
+                                                            FWLU_iterator __before, size_t __n)
+{
+    if(__list == __src_list || __n == 0 || FWLU_empty(__src_list))
+    {
+        return;
+    }
+    FWLU_check_size(__list, __src_list, "FWLU_splice_after_range()");
+    Forward_List_Unrolled_Node* __prev = NULL;
+    if(__before.node != FWLU_sentinel(__src_list))
+    {
+        __prev = __before.node;
+        if(__before.index + 1 < __prev->used)
+        {
+            FWLU_split(__src_list, __prev, __before.index + 1);
+        }
+    }
+    Forward_List_Unrolled_Node* __first = __prev ? __prev->next : __src_list->start;
+    if(!__first)
+    {
+        return;
+    }
+    Forward_List_Unrolled_Node* __last = __first;
+    size_t __moved = __last->used;
+    while(__moved < __n && __last->next)
+    {
+        __last = __last->next;
+        __moved += __last->used;
+    }
+    if(__moved > __n)
+    {
+        FWLU_split(__src_list, __last, __last->used - (__moved - __n));
+        __moved = __n;
+    }
+    if(__prev)
+    {
+        __prev->next = __last->next;
+    }
+    else
+    {
+        __src_list->start = __last->next;
+    }
+    if(__src_list->finish == __last)
+    {
+        __src_list->finish = __prev;
+    }
+    __src_list->count -= __moved;
+    if(__prev)
+    {
+        FWLU_merge_next(__src_list, __prev);
+    }
+    __last->next = NULL;
+    Forward_List_Unrolled __range = *__src_list;
+    __range.start = __first;
+    __range.finish = __last;
+    __range.count = __moved;
+    FWLU_splice_after_list(__list, __position, &__range);
+}
+
+void FWLU_for_each(Forward_List_Unrolled* __list, void (*__fn)(void *, void *), void* __ctx)
+{
+    for (Forward_List_Unrolled_Node* __node = __list->start; __node; __node = __node->next)
+    {
+        Forward_List_Generic* __it = __node->storage;
+        for (size_t __i = 0; __i < __node->used; ++__i, __it += __list->size)
+        {
+            __fn(__it, __ctx);
+        }
+    }
+}
+
+/*
+ * Compacts every node in place, keeping the elements for which __drop
+ * returns false. __last is the last element kept so far, or NULL.
+ */
+static void FWLU_filter(Forward_List_Unrolled* __list, int (*__drop)(const void *, const void *, void *), void* __ctx)
+{
+    Forward_List_Unrolled_Node* __prev = NULL;
+    Forward_List_Unrolled_Node* __node = __list->start;
+    const void* __last = NULL;
+    while(__node)
+    {
+        size_t __kept = 0;
+        for (size_t __i = 0; __i < __node->used; ++__i)
+        {
+            Forward_List_Generic* __elem = FWLU_element(__list, __node, __i);
+            if(__drop(__elem, __last, __ctx))
+            {
+                continue;
+            }
+            if(__kept != __i)
+            {
+                memcpy(FWLU_element(__list, __node, __kept), __elem, __list->size);
+            }
+            __last = FWLU_element(__list, __node, __kept);
+            ++__kept;
+        }
+        __list->count -= __node->used - __kept;
+        __node->used = __kept;
+        Forward_List_Unrolled_Node* __next = __node->next;
+        if(!__kept)
+        {
+            FWLU_drop_node(__list, __prev, __node);
+        }
+        else if(__prev && FWLU_merge_next(__list, __prev))
+        {
+            __last = FWLU_element(__list, __prev, __prev->used - 1);
+        }
+        else
+        {
+            __prev = __node;
+        }
+        __node = __next;
+    }
+}
+
+static int FWLU_drop_if(const void* __elem, const void* __last, void* __ctx)
+{
+    int (**__predicate)(const void *) = (int (**)(const void *)) __ctx;
+    (void) __last;
+    return (*__predicate)(__elem);
+}
+
+void FWLU_remove_if(Forward_List_Unrolled* __list, int (*__predicate)(const void *))
+{
+    FWLU_filter(__list, FWLU_drop_if, &__predicate);
+}
+
+static int FWLU_drop_duplicate(const void* __elem, const void* __last, void* __ctx)
+{
+    int (**__compare)(const void *, const void *) = (int (**)(const void *, const void *)) __ctx;
+    return __last && (*__compare)(__last, __elem);
+}
+
+void FWLU_unique(Forward_List_Unrolled* __list, int (*__compare)(const void *, const void *))
+{
+    FWLU_filter(__list, FWLU_drop_duplicate, &__compare);
+}
+
+int FWLU_empty(Forward_List_Unrolled* __list)
+{
+    return __list->start == NULL;
+}
+
+size_t FWLU_size(Forward_List_Unrolled* __list)
+{
+    return __list->count;
+}
+
+void FWLU_clear(Forward_List_Unrolled* __list)
+{
+    Forward_List_Unrolled_Node* __node = __list->start;
+    while(__node)
+    {
+        Forward_List_Unrolled_Node* __next = __node->next;
+        free(__node);
+        __node = __next;
+    }
+    __list->start = NULL;
+    __list->finish = NULL;
+    __list->count = 0;
+}
+
+Forward_List_Unrolled FWLU_Init(size_t __size)
+{
+    size_t __capacity = (FWLU_NODE_BYTES - sizeof(Forward_List_Unrolled_Node)) / (__size ? __size : 1);
+    if(__capacity == 0)
+    {
+        __capacity = 1;
+    }
+    Forward_List_Unrolled temp = {.start = NULL, .start_used = 0, .finish = NULL,
+                                  .count = 0, .size = __size,
+                                  .capacity = __capacity};
+    return temp;
+}
@@ -0,0 +1,101 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../include/forward_list_atomic.h"
+#include "../include/forward_list_epoch.h"
+#include "test_check.h"
+
+/*
+ * PRODUCERS threads push distinct values, one by one and in lists,
+ * while CONSUMERS threads pop them one by one and take them all at
+ * once. Every value must be seen exactly once.
+ */
+#define PRODUCERS 4
+#define CONSUMERS 4
+#define PER_PRODUCER 20000
+#define TOTAL (PRODUCERS * PER_PRODUCER)
+
+static Forward_List_Atomic list;
+static atomic_uchar seen[TOTAL];
+static atomic_size_t consumed;
+
+static void see(long __value)
+{
+    CHECK(__value >= 0 && __value < TOTAL);
+    CHECK(atomic_fetch_add(&seen[__value], 1) == 0);
+    atomic_fetch_add(&consumed, 1);
+}
+
+static void* produce(void* __arg)
+{
+    long __base = (long) __arg * PER_PRODUCER;
+    for (long __i = 0; __i < PER_PRODUCER; )
+    {
+        if(__i % 10 == 0 && __i + 5 <= PER_PRODUCER)
+        {
+            Forward_List __batch = FWL_Init(sizeof(long));
+            for (int __k = 0; __k < 5; ++__k, ++__i)
+            {
+                FWL_push_back(long, &__batch, __base + __i);
+            }
+            FWLA_push_list(&list, &__batch);
+            CHECK(FWL_empty(&__batch));
+        }
+        else
+        {
+            FWLA_push_front(long, &list, __base + __i++);
+        }
+    }
+    return NULL;
+}
+
+static void* consume(void* __arg)
+{
+    long __id = (long) __arg;
+    for (unsigned long __round = 0; atomic_load(&consumed) < TOTAL; ++__round)
+    {
+        if(__id == 0 && __round % 64 == 0)
+        {
+            Forward_List __all = FWLA_take_all(&list);
+            for (FWL_iterator __it = FWL_begin(&__all); __it; __it = __it->next)
+            {
+                see(FWL_cast(long, __it));
+            }
+            FWL_clear(&__all);
+        }
+        else
+        {
+            long __value;
+            if(FWLA_pop_front(&list, &__value))
+            {
+                see(__value);
+            }
+        }
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    FWLA_Init(&list, sizeof(long));
+    pthread_t __threads[PRODUCERS + CONSUMERS];
+    for (long __i = 0; __i < PRODUCERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[__i], NULL, produce, (void*) __i) == 0);
+    }
+    for (long __i = 0; __i < CONSUMERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[PRODUCERS + __i], NULL, consume, (void*) __i) == 0);
+    }
+    for (int __i = 0; __i < PRODUCERS + CONSUMERS; ++__i)
+    {
+        pthread_join(__threads[__i], NULL);
+    }
+    for (long __i = 0; __i < TOTAL; ++__i)
+    {
+        CHECK(atomic_load(&seen[__i]) == 1);
+    }
+    CHECK(FWLA_empty(&list));
+    CHECK(FWLA_size(&list) == 0);
+    FWL_epoch_flush();
+    return 0;
+}
@@ -0,0 +1,59 @@
+/**
+ *  @brief Minimal checking macro shared by the tests.
+ *
+ *  @file test_check.h
+ *  @author Mohamed fareed.
+ */
+
+#ifndef FORWARD_LIST_TEST_CHECK
+#define FORWARD_LIST_TEST_CHECK
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* Reports the failed condition and its location, then exits. */
+#define CHECK(__cond) do                                                  \
+{                                                                         \
+    if(!(__cond))                                                         \
+    {                                                                     \
+        printf("%s:%d : check failed: %s\n", __FILE__, __LINE__, #__cond);\
+        exit(EXIT_FAILURE);                                               \
+    }                                                                     \
+} while(0)
+
+/*
+ * Runs __fn(__ctx) in a child process, which has to exit with
+ * EXIT_FAILURE after printing a message containing __message.
+ */
+static inline void check_exits(void (*__fn)(void *), void* __ctx, const char* __message)
+{
+    int __out[2];
+    CHECK(pipe(__out) == 0);
+    fflush(stdout);
+    pid_t __child = fork();
+    CHECK(__child >= 0);
+    if(__child == 0)
+    {
+        dup2(__out[1], STDOUT_FILENO);
+        __fn(__ctx);
+        _exit(0);
+    }
+    close(__out[1]);
+    char __printed[512] = {0};
+    size_t __length = 0;
+    for (ssize_t __k; __length < sizeof(__printed) - 1 &&
+                      (__k = read(__out[0], __printed + __length, sizeof(__printed) - 1 - __length)) > 0;)
+    {
+        __length += (size_t) __k;
+    }
+    close(__out[0]);
+    int __status = 0;
+    CHECK(waitpid(__child, &__status, 0) == __child);
+    CHECK(WIFEXITED(__status) && WEXITSTATUS(__status) == EXIT_FAILURE);
+    CHECK(strstr(__printed, __message));
+}
+
+#endif
@@ -0,0 +1,51 @@
+#include <stdint.h>
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const int*) __x > *(const int*) __y;
+}
+
+/* Values 0..n-1 in order, in nodes of increasing address. */
+static void check_compacted(Forward_List* __list, int __n)
+{
+    int __expected = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__expected)
+    {
+        CHECK(FWL_cast(int, __it) == __expected);
+        CHECK(!__it->next || (uintptr_t) __it < (uintptr_t) __it->next);
+    }
+    CHECK(__expected == __n);
+    CHECK(FWL_size(__list) == (size_t) __n);
+}
+
+static void check_allocator(Forward_List __list)
+{
+    const int __n = 5000;
+    for (int __i = 0; __i < __n; ++__i)
+    {
+        FWL_push_front(int, &__list, (__i * 7919) % __n);
+    }
+    FWL_sort(&__list, greater);
+    FWL_compact(&__list);
+    check_compacted(&__list, __n);
+
+    FWL_reverse(&__list);
+    FWL_iterator __before = FWL_before_begin(&__list);
+    while((__before = FWL_compact_some(&__list, __before, 100)))
+    {
+    }
+    FWL_sort(&__list, greater);
+    FWL_compact(&__list);
+    check_compacted(&__list, __n);
+    FWL_clear(&__list);
+}
+
+int main(void)
+{
+    check_allocator(FWL_Init(sizeof(int)));
+    check_allocator(FWL_Init_pooled(sizeof(int)));
+    check_allocator(FWL_Init_arena(sizeof(int), 0));
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+/* Hashed and compared on key only, tag tells occurrences apart. */
+struct Pair
+{
+    int key;
+    int tag;
+};
+
+static size_t hash_key(const void* __x)
+{
+    return (size_t) ((const struct Pair*) __x)->key * 2654435761u;
+}
+
+/* Every element collides. */
+static size_t hash_constant(const void* __x)
+{
+    (void) __x;
+    return 42;
+}
+
+static int equal_key(const void* __x, const void* __y)
+{
+    return ((const struct Pair*) __x)->key == ((const struct Pair*) __y)->key;
+}
+
+enum { N = 3000, KEYS = 257 };
+
+static int key_of(int __i)
+{
+    return (__i * 7919 + __i / 5) % KEYS;
+}
+
+static void fill(Forward_List* __list)
+{
+    for (int __i = 0; __i < N; ++__i)
+    {
+        FWL_push_back(struct Pair, __list, {.key = key_of(__i), .tag = __i});
+    }
+}
+
+/* The list holds the elements of tags __expected in order. */
+static void check_tags(Forward_List* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    FWL_iterator __last = NULL;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__i)
+    {
+        struct Pair __value = FWL_cast(struct Pair, __it);
+        CHECK(__i < __n && __value.tag == __expected[__i] && __value.key == key_of(__expected[__i]));
+        __last = __it;
+    }
+    CHECK(__i == __n && FWL_size(__list) == __n);
+    CHECK(FWL_rbegin(__list) == __last);
+}
+
+/* The first occurrence of every key stays, in list order. */
+static void check_unique(Forward_List __list, size_t (*__hash)(const void *))
+{
+    static int __expected[N];
+    int __seen[KEYS] = {0};
+    size_t __n = 0;
+    for (int __i = 0; __i < N; ++__i)
+    {
+        if(!__seen[key_of(__i)]++)
+        {
+            __expected[__n++] = __i;
+        }
+    }
+    fill(&__list);
+    FWL_unique_hashed(&__list, __hash, equal_key);
+    check_tags(&__list, __expected, __n);
+    FWL_unique_hashed(&__list, __hash, equal_key);
+    check_tags(&__list, __expected, __n);
+    FWL_push_back(struct Pair, &__list, {.key = -1, .tag = -1});
+    CHECK(FWL_cast(struct Pair, FWL_rbegin(&__list)).tag == -1);
+    FWL_clear(&__list);
+}
+
+/* Every element equal to one of the values goes, the others stay in order. */
+static void check_remove_any(Forward_List __list, size_t (*__hash)(const void *))
+{
+    /* Repeated values and values absent from the list included. */
+    const struct Pair __values[] = {{3, 0}, {0, 0}, {KEYS - 1, 0}, {3, 0}, {KEYS + 5, 0}, {-7, 0}, {100, 0}};
+    const size_t __k = sizeof(__values) / sizeof(__values[0]);
+    static int __expected[N];
+    size_t __n = 0;
+    for (int __i = 0; __i < N; ++__i)
+    {
+        int __key = key_of(__i);
+        if(__key != 3 && __key != 0 && __key != KEYS - 1 && __key != 100)
+        {
+            __expected[__n++] = __i;
+        }
+    }
+    fill(&__list);
+    FWL_remove_any(&__list, __values, __k, __hash, equal_key);
+    check_tags(&__list, __expected, __n);
+
+    /* Values covering the whole list leave it empty. */
+    static struct Pair __all[KEYS];
+    for (int __i = 0; __i < KEYS; ++__i)
+    {
+        __all[__i] = (struct Pair) {.key = __i, .tag = 0};
+    }
+    FWL_remove_any(&__list, __all, KEYS, __hash, equal_key);
+    check_tags(&__list, NULL, 0);
+    FWL_push_back(struct Pair, &__list, {.key = -1, .tag = -1});
+    CHECK(FWL_size(&__list) == 1);
+    FWL_clear(&__list);
+}
+
+int main(void)
+{
+    size_t (*__hashes[])(const void *) = {hash_key, hash_constant};
+    for (size_t __h = 0; __h < 2; ++__h)
+    {
+        check_unique(FWL_Init(sizeof(struct Pair)), __hashes[__h]);
+        check_unique(FWL_Init_pooled(sizeof(struct Pair)), __hashes[__h]);
+        check_unique(FWL_Init_arena(sizeof(struct Pair), 0), __hashes[__h]);
+        check_remove_any(FWL_Init(sizeof(struct Pair)), __hashes[__h]);
+        check_remove_any(FWL_Init_pooled(sizeof(struct Pair)), __hashes[__h]);
+        check_remove_any(FWL_Init_arena(sizeof(struct Pair), 0), __hashes[__h]);
+    }
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+/* Checks the elements of an int list, its size and its last node. */
+static void check_ints(Forward_List* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__i)
+    {
+        CHECK(__i < __n);
+        CHECK(FWL_cast(int, __it) == __expected[__i]);
+    }
+    CHECK(__i == __n);
+    CHECK(FWL_size(__list) == __n);
+    CHECK(__n == 0 || FWL_cast(int, FWL_rbegin(__list)) == __expected[__n - 1]);
+}
+
+int main(void)
+{
+    /* FWL_rbegin() of an empty list is null, it must still insert. */
+    Forward_List __list = FWL_Init(sizeof(int));
+    FWL_insert_after_ilist(int, &__list, FWL_rbegin(&__list), {1, 2, 3});
+    check_ints(&__list, (int[]) {1, 2, 3}, 3);
+
+    FWL_insert_after_ilist(int, &__list, FWL_rbegin(&__list), {4, 5});
+    check_ints(&__list, (int[]) {1, 2, 3, 4, 5}, 5);
+    FWL_clear(&__list);
+
+    const int __data[] = {7, 8};
+    FWL_iterator __last = FWL_insert_after_array(&__list, FWL_rbegin(&__list), __data, 2);
+    CHECK(__last == FWL_rbegin(&__list));
+    check_ints(&__list, __data, 2);
+    FWL_clear(&__list);
+
+    /* Nothing to insert leaves the list alone. */
+    CHECK(FWL_insert_after_array(&__list, FWL_rbegin(&__list), __data, 0) == NULL);
+    check_ints(&__list, NULL, 0);
+
+    Forward_List __arena = FWL_Init_arena(sizeof(int), 0);
+    FWL_insert_after_ilist(int, &__arena, FWL_rbegin(&__arena), {9, 10});
+    FWL_push_back(int, &__arena, 11);
+    check_ints(&__arena, (int[]) {9, 10, 11}, 3);
+    FWL_clear(&__arena);
+    return 0;
+}
@@ -0,0 +1,156 @@
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+/* Linked twice, neither link at offset 0. */
+struct Item
+{
+    int value;
+    Forward_List_Link by_value;
+    char tag;
+    Forward_List_Link by_order;
+    int order;
+};
+
+enum { N = 5000 };
+
+static struct Item items[N];
+
+static int greater_value(const void* __x, const void* __y)
+{
+    return ((const struct Item*) __x)->value > ((const struct Item*) __y)->value;
+}
+
+static int odd_value(const void* __x)
+{
+    return ((const struct Item*) __x)->value & 1;
+}
+
+static void check_entry(void* __value, void* __ctx)
+{
+    const struct Item* __item = (const struct Item*) __value;
+    (void) __ctx;
+    CHECK(__item >= items && __item < items + N && __item->tag == 'x');
+}
+
+/* The by_order list holds every item in order, untouched by the other one. */
+static void check_by_order(Forward_List* __list)
+{
+    int __expected = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__expected)
+    {
+        struct Item* __item = FWL_entry(struct Item, by_order, __it);
+        CHECK(__item == &items[__expected] && __item->order == __expected);
+    }
+    CHECK(__expected == N && FWL_size(__list) == N);
+}
+
+static void check_two_lists(size_t __n)
+{
+    Forward_List __by_value = FWL_Init_intrusive(struct Item, by_value);
+    Forward_List __by_order = FWL_Init_intrusive(struct Item, by_order);
+    for (int __i = 0; __i < N; ++__i)
+    {
+        items[__i] = (struct Item) {.value = (__i * 7919) % N, .tag = 'x', .order = __i};
+        FWL_link_after(&__by_order, FWL_rbegin(&__by_order), &items[__i].by_order);
+    }
+    /* Only the first __n items in the other list, so both sort paths run. */
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        FWL_link_after(&__by_value, FWL_before_begin(&__by_value), &items[__i].by_value);
+    }
+    FWL_for_each(&__by_value, check_entry, NULL);
+
+    FWL_sort(&__by_value, greater_value);
+    int __prev = -1;
+    for (FWL_iterator __it = FWL_begin(&__by_value); __it; __it = __it->next)
+    {
+        struct Item* __item = FWL_entry(struct Item, by_value, __it);
+        CHECK(__item->value > __prev);
+        __prev = __item->value;
+    }
+    CHECK(FWL_entry(struct Item, by_value, FWL_rbegin(&__by_value))->value == __prev);
+    check_by_order(&__by_order);
+
+    size_t __odd = 0;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        __odd += items[__i].value & 1;
+    }
+    FWL_remove_if(&__by_value, odd_value);
+    CHECK(FWL_size(&__by_value) == __n - __odd);
+    for (FWL_iterator __it = FWL_begin(&__by_value); __it; __it = __it->next)
+    {
+        CHECK(!(FWL_entry(struct Item, by_value, __it)->value & 1));
+    }
+    check_by_order(&__by_order);
+
+    /* Erasing and clearing only unlink, the items are static and stay valid. */
+    FWL_erase_after(&__by_value, FWL_begin(&__by_value), NULL);
+    CHECK(FWL_size(&__by_value) == 1);
+    FWL_pop_front(&__by_value);
+    CHECK(FWL_empty(&__by_value));
+    FWL_erase_after(&__by_order, FWL_before_begin(&__by_order), FWL_advance(FWL_begin(&__by_order), 10));
+    CHECK(FWL_size(&__by_order) == N - 10);
+    FWL_clear(&__by_order);
+    CHECK(FWL_empty(&__by_order));
+    for (int __i = 0; __i < N; ++__i)
+    {
+        CHECK(items[__i].tag == 'x' && items[__i].order == __i);
+    }
+}
+
+/* A one item intrusive list, on which allocating has to exit. */
+static Forward_List make_list(void)
+{
+    Forward_List __list = FWL_Init_intrusive(struct Item, by_order);
+    items[0].tag = 'x';
+    FWL_link_after(&__list, FWL_before_begin(&__list), &items[0].by_order);
+    return __list;
+}
+
+static void push(void* __ctx)
+{
+    Forward_List __list = make_list();
+    (void) __ctx;
+    FWL_push_front(int, &__list, 1);
+}
+
+static void insert(void* __ctx)
+{
+    Forward_List __list = make_list();
+    (void) __ctx;
+    FWL_insert_after_array(&__list, FWL_begin(&__list), items, 2);
+}
+
+static void assign(void* __ctx)
+{
+    Forward_List __list = make_list();
+    (void) __ctx;
+    FWL_from_array(&__list, items, 2);
+}
+
+static void copy(void* __ctx)
+{
+    Forward_List __list = make_list();
+    (void) __ctx;
+    _FWL_copy(&__list);
+}
+
+static void compact(void* __ctx)
+{
+    Forward_List __list = make_list();
+    (void) __ctx;
+    FWL_compact(&__list);
+}
+
+int main(void)
+{
+    check_two_lists(100);
+    check_two_lists(N);
+    check_exits(push, NULL, "FWL_get_node() : intrusive lists do not allocate");
+    check_exits(insert, NULL, "FWL_get_nodes() : intrusive lists do not allocate");
+    check_exits(assign, NULL, "FWL_from_array() : intrusive lists do not allocate");
+    check_exits(copy, NULL, "FWL_copy() : intrusive lists do not allocate");
+    check_exits(compact, NULL, "FWL_compact() : intrusive lists do not allocate");
+    return 0;
+}
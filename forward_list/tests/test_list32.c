@@ -0,0 +1,214 @@
+#include <stdint.h>
+#include "../include/forward_list32.h"
+#include "test_check.h"
+
+struct Keyed
+{
+    int key;
+    int order;
+};
+
+static int greater_key(const void* __x, const void* __y)
+{
+    return ((const struct Keyed*) __x)->key > ((const struct Keyed*) __y)->key;
+}
+
+/*
+ * The list holds exactly __expected, finish is the last element and
+ * FWL32_rbegin() the before-begin sentinel when empty.
+ */
+static void check_list(Forward_List32* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    FWL32_iterator __last = FWL32_BEFORE_BEGIN;
+    for (FWL32_iterator __it = FWL32_begin(__list); __it != FWL32_end(__list); __it = FWL32_next(__list, __it), ++__i)
+    {
+        CHECK(__i < __n && FWL32_cast(int, __list, __it) == __expected[__i]);
+        __last = __it;
+    }
+    CHECK(__i == __n && FWL32_size(__list) == __n);
+    CHECK(FWL32_rbegin(__list) == __last);
+    CHECK(__list->finish == (__n ? __last : FWL32_NIL));
+}
+
+/* Returns the iterator to the element at __pos, or before-begin for -1. */
+static FWL32_iterator at(Forward_List32* __list, long __pos)
+{
+    FWL32_iterator __it = FWL32_before_begin(__list);
+    for (long __i = -1; __i < __pos; ++__i)
+    {
+        __it = FWL32_next(__list, __it);
+    }
+    return __it;
+}
+
+/* Erased nodes are handed out again before the arena is extended. */
+static void check_free_list(void)
+{
+    Forward_List32 __list = FWL32_init(int, {0, 1, 2, 3, 4});
+    uint32_t __used = __list.used;
+    FWL32_iterator __second = at(&__list, 1);
+    FWL32_iterator __fourth = at(&__list, 3);
+
+    CHECK(FWL32_cast(int, &__list, FWL32_pop_after(&__list, at(&__list, 2))) == 4);
+    CHECK(FWL32_cast(int, &__list, FWL32_pop_after(&__list, at(&__list, 0))) == 2);
+    check_list(&__list, (const int[]) {0, 2, 4}, 3);
+
+    /* Last freed, first reused. */
+    CHECK(FWL32_push_back(int, &__list, 5) == __second);
+    CHECK(FWL32_push_front(int, &__list, -1) == __fourth);
+    CHECK(__list.used == __used);
+    check_list(&__list, (const int[]) {-1, 0, 2, 4, 5}, 5);
+
+    FWL32_push_back(int, &__list, 6);
+    CHECK(__list.used == __used + 1);
+    FWL32_erase_after(&__list, at(&__list, 0), at(&__list, 4));
+    check_list(&__list, (const int[]) {-1, 5, 6}, 3);
+    FWL32_pop_front(&__list);
+    FWL32_pop_front(&__list);
+    FWL32_pop_front(&__list);
+    check_list(&__list, NULL, 0);
+    CHECK(FWL32_pop_after(&__list, FWL32_before_begin(&__list)) == FWL32_end(&__list));
+    FWL32_clear(&__list);
+}
+
+/* Iterators are indices, they survive the arena moving. */
+static void check_growth(void)
+{
+    Forward_List32 __list = FWL32_Init(sizeof(int));
+    FWL32_iterator __held[8];
+    for (int __i = 0; __i < 8; ++__i)
+    {
+        __held[__i] = FWL32_push_back(int, &__list, __i);
+    }
+    uint32_t __capacity = __list.capacity;
+    for (int __i = 8; __i < 10000; ++__i)
+    {
+        FWL32_push_back(int, &__list, __i);
+    }
+    CHECK(__list.capacity > __capacity);
+    for (int __i = 0; __i < 8; ++__i)
+    {
+        CHECK(FWL32_cast(int, &__list, __held[__i]) == __i);
+        FWL32_cast(int, &__list, __held[__i]) = -__i;
+    }
+    FWL32_insert_after(int, &__list, __held[3], 100);
+    int __expected = 0;
+    int __i = 0;
+    for (FWL32_iterator __it = FWL32_begin(&__list); __it != FWL32_end(&__list); __it = FWL32_next(&__list, __it), ++__i)
+    {
+        int __value = FWL32_cast(int, &__list, __it);
+        if(__i == 4)
+        {
+            CHECK(__value == 100);
+            continue;
+        }
+        CHECK(__value == (__expected < 8 ? -__expected : __expected));
+        ++__expected;
+    }
+    CHECK(__expected == 10000 && FWL32_size(&__list) == 10001);
+    FWL32_clear(&__list);
+}
+
+/* Between two lists the elements are copied out of the source. */
+static void check_splice_lists(void)
+{
+    Forward_List32 __list = FWL32_init(int, {0, 1, 2});
+    Forward_List32 __src = FWL32_init(int, {10, 11, 12, 13, 14, 15});
+
+    FWL32_splice_after_element(&__list, at(&__list, 0), &__src, at(&__src, 1));
+    check_list(&__list, (const int[]) {0, 12, 1, 2}, 4);
+    check_list(&__src, (const int[]) {10, 11, 13, 14, 15}, 5);
+
+    FWL32_splice_after_range(&__list, FWL32_rbegin(&__list), &__src, at(&__src, 0), at(&__src, 3));
+    check_list(&__list, (const int[]) {0, 12, 1, 2, 11, 13}, 6);
+    check_list(&__src, (const int[]) {10, 14, 15}, 3);
+
+    /* The range up to the end leaves the source finish on its new last element. */
+    FWL32_splice_after_range(&__list, FWL32_before_begin(&__list), &__src, at(&__src, 0), FWL32_end(&__src));
+    check_list(&__list, (const int[]) {14, 15, 0, 12, 1, 2, 11, 13}, 8);
+    check_list(&__src, (const int[]) {10}, 1);
+    FWL32_push_back(int, &__src, 16);
+    check_list(&__src, (const int[]) {10, 16}, 2);
+
+    FWL32_splice_after_list(&__list, at(&__list, 1), &__src);
+    check_list(&__list, (const int[]) {14, 15, 10, 16, 0, 12, 1, 2, 11, 13}, 10);
+    check_list(&__src, NULL, 0);
+    CHECK(__src.nodes == NULL);
+
+    /* An empty destination, before any arena exists. */
+    Forward_List32 __empty = FWL32_Init(sizeof(int));
+    FWL32_splice_after_list(&__empty, FWL32_before_begin(&__empty), &__list);
+    check_list(&__empty, (const int[]) {14, 15, 10, 16, 0, 12, 1, 2, 11, 13}, 10);
+    check_list(&__list, NULL, 0);
+    FWL32_clear(&__empty);
+}
+
+/* Within one list ranges and elements are relinked, finish follows. */
+static void check_splice_same(void)
+{
+    Forward_List32 __list = FWL32_init(int, {0, 1, 2, 3, 4, 5});
+    FWL32_iterator __three = at(&__list, 3);
+
+    /* The tail to the front. */
+    FWL32_splice_after_range(&__list, FWL32_before_begin(&__list), &__list, at(&__list, 3), FWL32_end(&__list));
+    check_list(&__list, (const int[]) {4, 5, 0, 1, 2, 3}, 6);
+    CHECK(FWL32_rbegin(&__list) == __three);
+
+    /* A middle range to the end. */
+    FWL32_splice_after_range(&__list, FWL32_rbegin(&__list), &__list, at(&__list, 0), at(&__list, 3));
+    check_list(&__list, (const int[]) {4, 1, 2, 3, 5, 0}, 6);
+
+    FWL32_splice_after_element(&__list, FWL32_rbegin(&__list), &__list, FWL32_before_begin(&__list));
+    check_list(&__list, (const int[]) {1, 2, 3, 5, 0, 4}, 6);
+    FWL32_splice_after_element(&__list, FWL32_before_begin(&__list), &__list, at(&__list, 4));
+    check_list(&__list, (const int[]) {4, 1, 2, 3, 5, 0}, 6);
+    FWL32_clear(&__list);
+}
+
+static void check_sort_reverse(void)
+{
+    enum { N = 2000, KEYS = 7 };
+    Forward_List32 __list = FWL32_Init(sizeof(struct Keyed));
+    for (int __i = 0; __i < N; ++__i)
+    {
+        FWL32_push_back(struct Keyed, &__list, {.key = (__i * 5) % KEYS, .order = __i});
+    }
+    FWL32_sort(&__list, greater_key);
+    struct Keyed __prev = {.key = -1, .order = -1};
+    size_t __n = 0;
+    FWL32_iterator __last = FWL32_NIL;
+    for (FWL32_iterator __it = FWL32_begin(&__list); __it != FWL32_end(&__list); __it = FWL32_next(&__list, __it), ++__n)
+    {
+        struct Keyed __value = FWL32_cast(struct Keyed, &__list, __it);
+        CHECK(__value.key > __prev.key || (__value.key == __prev.key && __value.order > __prev.order));
+        __prev = __value;
+        __last = __it;
+    }
+    CHECK(__n == N && FWL32_rbegin(&__list) == __last);
+
+    FWL32_reverse(&__list);
+    __n = 0;
+    __prev = (struct Keyed) {.key = KEYS, .order = N};
+    for (FWL32_iterator __it = FWL32_begin(&__list); __it != FWL32_end(&__list); __it = FWL32_next(&__list, __it), ++__n)
+    {
+        struct Keyed __value = FWL32_cast(struct Keyed, &__list, __it);
+        CHECK(__value.key < __prev.key || (__value.key == __prev.key && __value.order < __prev.order));
+        __prev = __value;
+        __last = __it;
+    }
+    CHECK(__n == N && FWL32_rbegin(&__list) == __last);
+    FWL32_push_back(struct Keyed, &__list, {.key = -1, .order = -1});
+    CHECK(FWL32_cast(struct Keyed, &__list, FWL32_rbegin(&__list)).key == -1);
+    FWL32_clear(&__list);
+}
+
+int main(void)
+{
+    check_free_list();
+    check_growth();
+    check_splice_lists();
+    check_splice_same();
+    check_sort_reverse();
+    return 0;
+}
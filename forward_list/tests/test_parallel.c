@@ -0,0 +1,149 @@
+#include <dirent.h>
+#include <stdatomic.h>
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+static int is_odd(const void* __x)
+{
+    return *(const int*) __x & 1;
+}
+
+static void add(void* __value, void* __ctx)
+{
+    atomic_fetch_add_explicit((atomic_long*) __ctx, *(int*) __value, memory_order_relaxed);
+}
+
+static void accumulate(void* __acc, const void* __value)
+{
+    *(long*) __acc += *(const int*) __value;
+}
+
+static void combine(void* __acc, const void* __other)
+{
+    *(long*) __acc += *(const long*) __other;
+}
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const int*) __x > *(const int*) __y;
+}
+
+/* Sorts and counts the inner list an element points to, if any. */
+static void sort_inner(void* __value, void* __ctx)
+{
+    Forward_List* __inner = *(Forward_List**) __value;
+    if(!__inner)
+    {
+        return;
+    }
+    FWL_sort_parallel(__inner, greater, 4);
+    atomic_fetch_add_explicit((atomic_long*) __ctx, (long) FWL_parallel_count_if(__inner, is_odd, 4),
+                              memory_order_relaxed);
+}
+
+/* A walk started from a task of the pool must not wait for the pool. */
+static void check_nested(void)
+{
+    enum { OUTER = 3 * 8192, INNER = 20000, LISTS = 8 };
+    Forward_List __inner[LISTS];
+    Forward_List __outer = FWL_Init(sizeof(Forward_List*));
+    for (int __l = 0; __l < LISTS; ++__l)
+    {
+        __inner[__l] = FWL_Init(sizeof(int));
+        for (int __i = 0; __i < INNER; ++__i)
+        {
+            FWL_push_front(int, &__inner[__l], __i);
+        }
+    }
+    for (int __i = 0; __i < OUTER; ++__i)
+    {
+        Forward_List* __target = __i % (OUTER / LISTS) ? NULL : &__inner[__i / (OUTER / LISTS)];
+        FWL_push_front(Forward_List*, &__outer, __target);
+    }
+
+    atomic_long __odd = 0;
+    FWL_parallel_for_each(&__outer, sort_inner, &__odd, 4);
+    CHECK(atomic_load(&__odd) == (long) LISTS * INNER / 2);
+    for (int __l = 0; __l < LISTS; ++__l)
+    {
+        int __expected = 0;
+        for (FWL_iterator __it = FWL_begin(&__inner[__l]); __it; __it = __it->next, ++__expected)
+        {
+            CHECK(FWL_cast(int, __it) == __expected);
+        }
+        CHECK(__expected == INNER);
+        FWL_clear(&__inner[__l]);
+    }
+    FWL_clear(&__outer);
+}
+
+static size_t count_threads(void)
+{
+    size_t __n = 0;
+    DIR* __dir = opendir("/proc/self/task");
+    CHECK(__dir);
+    for (struct dirent* __entry; (__entry = readdir(__dir));)
+    {
+        __n += __entry->d_name[0] != '.';
+    }
+    closedir(__dir);
+    return __n;
+}
+
+/* A list long enough for any number of threads still starts at most 63 workers. */
+static void check_cap(size_t __threads_before)
+{
+    const int __n = 80 * 8192;
+    Forward_List __list = FWL_Init(sizeof(int));
+    for (int __i = 0; __i < __n; ++__i)
+    {
+        FWL_push_front(int, &__list, __i);
+    }
+    CHECK(FWL_parallel_count_if(&__list, is_odd, 1000) == (size_t) __n / 2);
+    FWL_sort_parallel(&__list, greater, 1000);
+    CHECK(FWL_cast(int, FWL_begin(&__list)) == 0);
+    /* One more for the helper thread ThreadSanitizer starts on demand. */
+    CHECK(count_threads() - __threads_before <= 63 + 1);
+    FWL_clear(&__list);
+}
+
+/*
+ * Asks for far more threads than the list is long enough for, the walks
+ * have to clamp the count they hand to the workers.
+ */
+int main(void)
+{
+    size_t __threads = count_threads();
+    const int __n = 3 * 8192 + 17;
+    const long __sum = (long) __n * (__n - 1) / 2;
+    Forward_List __list = FWL_Init(sizeof(int));
+    for (int __i = __n - 1; __i >= 0; --__i)
+    {
+        FWL_push_front(int, &__list, __i);
+    }
+
+    atomic_long __total = 0;
+    FWL_parallel_for_each(&__list, add, &__total, 64);
+    CHECK(atomic_load(&__total) == __sum);
+
+    CHECK(FWL_parallel_count_if(&__list, is_odd, 64) == (size_t) __n / 2);
+
+    long __result = 0;
+    FWL_parallel_reduce(&__list, &__result, sizeof(long), accumulate, combine, 64);
+    CHECK(__result == __sum);
+
+    CHECK(FWL_parallel_remove_if(&__list, is_odd, 64) == (size_t) __n / 2);
+    CHECK(FWL_size(&__list) == (size_t) (__n + 1) / 2);
+    int __expected = 0;
+    for (FWL_iterator __it = FWL_begin(&__list); __it; __it = __it->next, __expected += 2)
+    {
+        CHECK(FWL_cast(int, __it) == __expected);
+    }
+    CHECK(__expected == __n + 1);
+
+    FWL_clear(&__list);
+
+    check_nested();
+    check_cap(__threads);
+    return 0;
+}
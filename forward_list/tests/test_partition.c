@@ -0,0 +1,136 @@
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+static int multiple_of_3(const void* __x)
+{
+    return *(const int*) __x % 3 == 0;
+}
+
+static int never(const void* __x)
+{
+    (void) __x;
+    return 0;
+}
+
+static int always(const void* __x)
+{
+    (void) __x;
+    return 1;
+}
+
+/* The list holds the values of __expected in order, FWL_rbegin() on the last. */
+static void check_list(Forward_List* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    FWL_iterator __last = NULL;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__i)
+    {
+        CHECK(__i < __n && FWL_cast(int, __it) == __expected[__i]);
+        __last = __it;
+    }
+    CHECK(__i == __n && FWL_size(__list) == __n);
+    CHECK(FWL_rbegin(__list) == __last);
+}
+
+static void fill(Forward_List* __list, int __n)
+{
+    for (int __i = 0; __i < __n; ++__i)
+    {
+        FWL_push_back(int, __list, (__i * 37) % __n);
+    }
+}
+
+/* Splits the values the way the functions should, matching ones first. */
+static size_t expect(int __n, int (*__predicate)(const void *), int* __matched, int* __others, size_t* __n_others)
+{
+    size_t __k = 0;
+    *__n_others = 0;
+    for (int __i = 0; __i < __n; ++__i)
+    {
+        int __value = (__i * 37) % __n;
+        if(__predicate(&__value))
+        {
+            __matched[__k++] = __value;
+        }
+        else
+        {
+            __others[(*__n_others)++] = __value;
+        }
+    }
+    return __k;
+}
+
+/* Without an output list the matching elements move to the front. */
+static void check_in_place(Forward_List __list, int (*__predicate)(const void *))
+{
+    enum { N = 1000 };
+    static int __matched[N], __others[N], __expected[N];
+    size_t __n_others = 0;
+    fill(&__list, N);
+    size_t __k = expect(N, __predicate, __matched, __others, &__n_others);
+    for (size_t __i = 0; __i < __k; ++__i)
+    {
+        __expected[__i] = __matched[__i];
+    }
+    for (size_t __i = 0; __i < __n_others; ++__i)
+    {
+        __expected[__k + __i] = __others[__i];
+    }
+    CHECK(FWL_partition(&__list, __predicate, NULL) == __k);
+    check_list(&__list, __expected, N);
+    FWL_push_back(int, &__list, -1);
+    CHECK(FWL_cast(int, FWL_rbegin(&__list)) == -1);
+    FWL_clear(&__list);
+}
+
+/* With one they are appended to it, after what it already holds. */
+static void check_extract(Forward_List __list, Forward_List __out, int (*__predicate)(const void *), int __partition)
+{
+    enum { N = 1000 };
+    static int __matched[N + 2], __others[N];
+    size_t __n_others = 0;
+    fill(&__list, N);
+    FWL_push_back(int, &__out, -1);
+    FWL_push_back(int, &__out, -2);
+    __matched[0] = -1;
+    __matched[1] = -2;
+    size_t __k = expect(N, __predicate, __matched + 2, __others, &__n_others);
+    size_t __moved = __partition ? FWL_partition(&__list, __predicate, &__out) : FWL_extract_if(&__list, __predicate, &__out);
+    CHECK(__moved == __k);
+    check_list(&__list, __others, __n_others);
+    check_list(&__out, __matched, __k + 2);
+
+    FWL_push_back(int, &__list, -3);
+    FWL_push_back(int, &__out, -4);
+    CHECK(FWL_cast(int, FWL_rbegin(&__list)) == -3 && FWL_cast(int, FWL_rbegin(&__out)) == -4);
+    FWL_clear(&__list);
+    FWL_clear(&__out);
+}
+
+static void extract_arenas(void* __ctx)
+{
+    Forward_List __list = FWL_Init_arena(sizeof(int), 0);
+    Forward_List __out = FWL_Init_arena(sizeof(int), 0);
+    (void) __ctx;
+    FWL_push_back(int, &__list, 3);
+    FWL_partition(&__list, multiple_of_3, &__out);
+}
+
+int main(void)
+{
+    int (*__predicates[])(const void *) = {multiple_of_3, never, always};
+    for (size_t __p = 0; __p < 3; ++__p)
+    {
+        check_in_place(FWL_Init(sizeof(int)), __predicates[__p]);
+        check_in_place(FWL_Init_pooled(sizeof(int)), __predicates[__p]);
+        check_in_place(FWL_Init_arena(sizeof(int), 0), __predicates[__p]);
+        for (int __partition = 0; __partition < 2; ++__partition)
+        {
+            check_extract(FWL_Init(sizeof(int)), FWL_Init(sizeof(int)), __predicates[__p], __partition);
+            check_extract(FWL_Init_pooled(sizeof(int)), FWL_Init_pooled(sizeof(int)), __predicates[__p], __partition);
+        }
+    }
+    /* Arena nodes cannot move to another list. */
+    check_exits(extract_arenas, NULL, "FWL_extract_if() : incompatible node allocators");
+    return 0;
+}
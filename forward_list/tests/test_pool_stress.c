@@ -0,0 +1,123 @@
+#include <pthread.h>
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+/*
+ * Pairs of threads pass pooled lists back and forth: the producer fills
+ * one, the consumer checks and clears it. Every node is allocated on one
+ * thread and released on the other, so it only comes back through the
+ * shared depot.
+ */
+enum { PAIRS = 2, ROUNDS = 50, BATCH = 1000 };
+
+struct Pair
+{
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    Forward_List* full;     /* Handed to the consumer, NULL once cleared. */
+    int done;
+};
+
+static void* producer(void* __arg)
+{
+    struct Pair* __pair = (struct Pair*) __arg;
+    Forward_List __list = FWL_Init_pooled(sizeof(long));
+    for (int __round = 0; __round < ROUNDS; ++__round)
+    {
+        for (long __i = 0; __i < BATCH; ++__i)
+        {
+            FWL_push_back(long, &__list, __round * BATCH + __i);
+        }
+        pthread_mutex_lock(&__pair->lock);
+        __pair->full = &__list;
+        pthread_cond_broadcast(&__pair->changed);
+        while(__pair->full)
+        {
+            pthread_cond_wait(&__pair->changed, &__pair->lock);
+        }
+        pthread_mutex_unlock(&__pair->lock);
+        CHECK(FWL_empty(&__list));
+    }
+    pthread_mutex_lock(&__pair->lock);
+    __pair->done = 1;
+    pthread_cond_broadcast(&__pair->changed);
+    pthread_mutex_unlock(&__pair->lock);
+    return NULL;
+}
+
+static void* consumer(void* __arg)
+{
+    struct Pair* __pair = (struct Pair*) __arg;
+    for (int __round = 0;; ++__round)
+    {
+        pthread_mutex_lock(&__pair->lock);
+        while(!__pair->full && !__pair->done)
+        {
+            pthread_cond_wait(&__pair->changed, &__pair->lock);
+        }
+        if(!__pair->full)
+        {
+            pthread_mutex_unlock(&__pair->lock);
+            CHECK(__round == ROUNDS);
+            return NULL;
+        }
+        Forward_List* __list = __pair->full;
+        long __expected = (long) __round * BATCH;
+        for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__expected)
+        {
+            CHECK(FWL_cast(long, __it) == __expected);
+        }
+        CHECK(__expected == (long) (__round + 1) * BATCH);
+        FWL_clear(__list);
+        __pair->full = NULL;
+        pthread_cond_broadcast(&__pair->changed);
+        pthread_mutex_unlock(&__pair->lock);
+    }
+}
+
+int main(void)
+{
+    Forward_List_Pool_Stats __before;
+    FWL_pool_stats(&__before);
+
+    struct Pair __pairs[PAIRS];
+    pthread_t __threads[2 * PAIRS];
+    for (int __p = 0; __p < PAIRS; ++__p)
+    {
+        __pairs[__p] = (struct Pair) {.full = NULL, .done = 0};
+        pthread_mutex_init(&__pairs[__p].lock, NULL);
+        pthread_cond_init(&__pairs[__p].changed, NULL);
+        CHECK(pthread_create(&__threads[2 * __p], NULL, producer, &__pairs[__p]) == 0);
+        CHECK(pthread_create(&__threads[2 * __p + 1], NULL, consumer, &__pairs[__p]) == 0);
+    }
+    for (int __t = 0; __t < 2 * PAIRS; ++__t)
+    {
+        pthread_join(__threads[__t], NULL);
+    }
+
+    /* The threads have exited, their counters and caches are folded in. */
+    Forward_List_Pool_Stats __after;
+    FWL_pool_stats(&__after);
+    size_t __hits = __after.hits - __before.hits;
+    size_t __misses = __after.misses - __before.misses;
+    CHECK(__hits + __misses == (size_t) PAIRS * ROUNDS * BATCH);
+    CHECK(__hits > __misses);
+    CHECK(__after.cached > 0);
+
+    FWL_pool_trim();
+    FWL_pool_stats(&__after);
+    CHECK(__after.cached == 0);
+
+    /* The pool keeps working once trimmed. */
+    Forward_List __list = FWL_Init_pooled(sizeof(long));
+    FWL_push_back(long, &__list, 7);
+    CHECK(FWL_size(&__list) == 1 && FWL_cast(long, FWL_begin(&__list)) == 7);
+    FWL_clear(&__list);
+
+    for (int __p = 0; __p < PAIRS; ++__p)
+    {
+        pthread_mutex_destroy(&__pairs[__p].lock);
+        pthread_cond_destroy(&__pairs[__p].changed);
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include <pthread.h>
+#include <sched.h>
+#include "../include/forward_list_queue.h"
+#include "test_check.h"
+
+/*
+ * PRODUCERS threads push their own increasing sequence, one by one and
+ * in lists, into a small queue that often rejects them, while the main
+ * thread consumes one by one and in lists. Every sequence must come out
+ * whole and in order.
+ */
+#define PRODUCERS 4
+#define PER_PRODUCER 50000
+#define CAPACITY 16
+
+static Forward_List_Queue queue;
+
+/* Checks capacity rejection on a queue nobody else uses. */
+static void check_capacity(void)
+{
+    Forward_List_Queue __queue;
+    FWLQ_Init(&__queue, sizeof(long), 4);
+    for (long __i = 0; __i < 3; ++__i)
+    {
+        CHECK(FWLQ_push(long, &__queue, __i));
+    }
+    Forward_List __batch = FWL_Init(sizeof(long));
+    FWL_push_back(long, &__batch, 4);
+    FWL_push_back(long, &__batch, 5);
+    CHECK(!FWLQ_push_list(&__queue, &__batch));
+    CHECK(FWL_size(&__batch) == 2);
+    CHECK(FWLQ_push(long, &__queue, 3));
+    CHECK(!FWLQ_push(long, &__queue, -1));
+    CHECK(FWLQ_size(&__queue) == 4);
+
+    Forward_List __out = FWL_Init(sizeof(long));
+    CHECK(FWLQ_pop_list(&__queue, &__out, 2) == 2);
+    CHECK(FWLQ_push_list(&__queue, &__batch));
+    CHECK(FWL_empty(&__batch));
+    CHECK(FWLQ_pop_list(&__queue, &__out, 10) == 4);
+    long __expected = 0;
+    for (FWL_iterator __it = FWL_begin(&__out); __it; __it = __it->next, ++__expected)
+    {
+        CHECK(FWL_cast(long, __it) == __expected);
+    }
+    CHECK(__expected == 6);
+    CHECK(FWLQ_empty(&__queue));
+    CHECK(!FWLQ_pop(&__queue, NULL));
+    FWL_clear(&__out);
+    FWLQ_Destroy(&__queue);
+}
+
+static void* produce(void* __arg)
+{
+    long __base = (long) __arg * PER_PRODUCER;
+    for (long __i = 0; __i < PER_PRODUCER; )
+    {
+        if(__i % 8 == 0 && __i + 5 <= PER_PRODUCER)
+        {
+            Forward_List __batch = FWL_Init(sizeof(long));
+            for (int __k = 0; __k < 5; ++__k)
+            {
+                FWL_push_back(long, &__batch, __base + __i + __k);
+            }
+            while(!FWLQ_push_list(&queue, &__batch))
+            {
+                CHECK(FWL_size(&__batch) == 5);
+                sched_yield();
+            }
+            __i += 5;
+        }
+        else if(FWLQ_push(long, &queue, __base + __i))
+        {
+            ++__i;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static long next_expected[PRODUCERS];
+
+static void see(long __value)
+{
+    long __producer = __value / PER_PRODUCER;
+    CHECK(__producer >= 0 && __producer < PRODUCERS);
+    CHECK(__value % PER_PRODUCER == next_expected[__producer]);
+    ++next_expected[__producer];
+}
+
+int main(void)
+{
+    check_capacity();
+
+    FWLQ_Init(&queue, sizeof(long), CAPACITY);
+    pthread_t __threads[PRODUCERS];
+    for (long __i = 0; __i < PRODUCERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[__i], NULL, produce, (void*) __i) == 0);
+    }
+    Forward_List __out = FWL_Init(sizeof(long));
+    for (long __seen = 0, __round = 0; __seen < PRODUCERS * PER_PRODUCER; ++__round)
+    {
+        long __value;
+        if(__round % 3 == 0)
+        {
+            __seen += FWLQ_pop_list(&queue, &__out, 7);
+            for (FWL_iterator __it = FWL_begin(&__out); __it; __it = __it->next)
+            {
+                see(FWL_cast(long, __it));
+            }
+            FWL_clear(&__out);
+        }
+        else if(FWLQ_pop(&queue, &__value))
+        {
+            see(__value);
+            ++__seen;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    for (int __i = 0; __i < PRODUCERS; ++__i)
+    {
+        pthread_join(__threads[__i], NULL);
+        CHECK(next_expected[__i] == PER_PRODUCER);
+    }
+    CHECK(FWLQ_empty(&queue));
+    CHECK(FWLQ_size(&queue) == 0);
+    FWLQ_Destroy(&queue);
+    return 0;
+}
@@ -0,0 +1,118 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../include/forward_list_rcu.h"
+#include "../include/forward_list_epoch.h"
+#include "test_check.h"
+
+/*
+ * A writer keeps updating a Forward_List_RCU, always sorted by key,
+ * through push_back, splice_back, remove_if, replace_after, erase_after
+ * and clear, while READERS threads walk it. Readers check that keys
+ * increase along every walk and that no element is torn or stale.
+ */
+#define READERS 4
+#define ROUNDS 3000
+
+struct Entry
+{
+    int key;
+    int generation;
+    int check;
+};
+
+#define ENTRY_CHECK(__key, __generation) ((__key) * 31 ^ (__generation) ^ 0x5a5a5a)
+
+static Forward_List_RCU list;
+static atomic_int writing;
+
+static struct Entry entry(int __key, int __generation)
+{
+    return (struct Entry) {__key, __generation, ENTRY_CHECK(__key, __generation)};
+}
+
+static int odd_key(const void* __value)
+{
+    return ((const struct Entry*) __value)->key & 1;
+}
+
+static void* read_entries(void* __arg)
+{
+    (void) __arg;
+    while(atomic_load(&writing))
+    {
+        FWLR_read_lock();
+        int __previous = -1;
+        for (FWL_iterator __it = FWLR_begin(&list); __it; __it = FWLR_next(__it))
+        {
+            const struct Entry* __entry = (const struct Entry*) FWLR_value(__it);
+            CHECK(__entry->check == ENTRY_CHECK(__entry->key, __entry->generation));
+            CHECK(__entry->key > __previous);
+            __previous = __entry->key;
+        }
+        FWLR_read_unlock();
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    FWLR_Init(&list, sizeof(struct Entry));
+    atomic_store(&writing, 1);
+    pthread_t __threads[READERS];
+    for (int __i = 0; __i < READERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[__i], NULL, read_entries, NULL) == 0);
+    }
+
+    int __next_key = 0;
+    size_t __expected = 0;
+    for (int __round = 0; __round < ROUNDS; ++__round)
+    {
+        for (int __i = 0; __i < 32; ++__i, ++__expected)
+        {
+            FWLR_push_back(struct Entry, &list, entry(__next_key++, 0));
+        }
+        Forward_List __batch = FWL_Init(sizeof(struct Entry));
+        for (int __i = 0; __i < 16; ++__i, ++__expected)
+        {
+            FWL_push_back(struct Entry, &__batch, entry(__next_key++, 0));
+        }
+        FWLR_splice_back(&list, &__batch);
+        CHECK(FWL_empty(&__batch));
+
+        __expected -= FWLR_remove_if(&list, odd_key);
+
+        FWLR_write_lock(&list);
+        FWL_iterator __before = FWLR_before_begin(&list);
+        if(__before->next)
+        {
+            struct Entry __first = *(struct Entry*) FWLR_value(__before->next);
+            FWLR_replace_after(struct Entry, &list, __before, entry(__first.key, __first.generation + 1));
+            FWLR_erase_after(&list, __before);
+            FWLR_insert_after(struct Entry, &list, __before, entry(__first.key, __first.generation + 2));
+        }
+        FWLR_write_unlock(&list);
+        CHECK(FWLR_size(&list) == __expected);
+
+        if(__round % 100 == 99)
+        {
+            FWLR_clear(&list);
+            __expected = 0;
+        }
+    }
+    atomic_store(&writing, 0);
+    for (int __i = 0; __i < READERS; ++__i)
+    {
+        pthread_join(__threads[__i], NULL);
+    }
+
+    size_t __linked = 0;
+    for (FWL_iterator __it = FWLR_begin(&list); __it; __it = __it->next, ++__linked)
+    {
+        CHECK(__it->next || __it == list.finish);
+    }
+    CHECK(__linked == __expected);
+    FWLR_Destroy(&list);
+    FWL_epoch_flush();
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+/* Compared on key only, tag tells which list and position it came from. */
+struct Pair
+{
+    int key;
+    int tag;
+};
+
+enum Operation { MERGE, UNION, INTERSECTION, DIFFERENCE };
+
+static int greater_key(const void* __x, const void* __y)
+{
+    return ((const struct Pair*) __x)->key > ((const struct Pair*) __y)->key;
+}
+
+static int greater_int(const void* __x, const void* __y)
+{
+    return *(const int*) __x > *(const int*) __y;
+}
+
+/* The list holds exactly __expected. */
+static int holds(Forward_List* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    for (FWL_iterator __it = FWL_begin(__list); __it; __it = __it->next, ++__i)
+    {
+        if(__i == __n || FWL_cast(int, __it) != __expected[__i])
+        {
+            return 0;
+        }
+    }
+    return __i == __n && FWL_size(__list) == __n;
+}
+
+/* The result std::merge or std::set_* gives on arrays. */
+static size_t reference(enum Operation __operation, const struct Pair* __a, size_t __na,
+                        const struct Pair* __b, size_t __nb, struct Pair* __out)
+{
+    size_t __i = 0, __j = 0, __n = 0;
+    while(__i < __na && __j < __nb)
+    {
+        if(__b[__j].key < __a[__i].key)
+        {
+            if(__operation == MERGE || __operation == UNION)
+            {
+                __out[__n++] = __b[__j];
+            }
+            ++__j;
+        }
+        else if(__a[__i].key < __b[__j].key || __operation == MERGE)
+        {
+            if(__operation != INTERSECTION)
+            {
+                __out[__n++] = __a[__i];
+            }
+            ++__i;
+        }
+        else
+        {
+            if(__operation != DIFFERENCE)
+            {
+                __out[__n++] = __a[__i];
+            }
+            ++__i;
+            ++__j;
+        }
+    }
+    for (; __i < __na && __operation != INTERSECTION; ++__i)
+    {
+        __out[__n++] = __a[__i];
+    }
+    for (; __j < __nb && (__operation == MERGE || __operation == UNION); ++__j)
+    {
+        __out[__n++] = __b[__j];
+    }
+    return __n;
+}
+
+static void fill(Forward_List* __list, struct Pair* __pairs, size_t __n, int __seed, int __tag)
+{
+    int __key = 0;
+    for (size_t __i = 0; __i < __n; ++__i)
+    {
+        /* Sorted, with runs of duplicates of varying length. */
+        __key += (int) ((__i * 7 + (size_t) __seed) % 5 == 0) + (int) ((__i * 3 + (size_t) __seed) % 11 == 0);
+        __pairs[__i] = (struct Pair) {.key = __key, .tag = __tag + (int) __i};
+        FWL_push_back(struct Pair, __list, __pairs[__i]);
+    }
+}
+
+static void run(Forward_List __list, Forward_List __src, enum Operation __operation, size_t __na, size_t __nb, int __seed)
+{
+    struct Pair __a[600], __b[600], __expected[1200];
+    fill(&__list, __a, __na, __seed, 0);
+    fill(&__src, __b, __nb, __seed * 3 + 1, 10000);
+    size_t __n = reference(__operation, __a, __na, __b, __nb, __expected);
+
+    switch(__operation)
+    {
+        case MERGE:        FWL_merge(&__list, &__src, greater_key);            break;
+        case UNION:        FWL_set_union(&__list, &__src, greater_key);        break;
+        case INTERSECTION: FWL_set_intersection(&__list, &__src, greater_key); break;
+        case DIFFERENCE:   FWL_set_difference(&__list, &__src, greater_key);   break;
+    }
+
+    size_t __i = 0;
+    FWL_iterator __last = NULL;
+    for (FWL_iterator __it = FWL_begin(&__list); __it; __it = __it->next, ++__i)
+    {
+        struct Pair __value = FWL_cast(struct Pair, __it);
+        CHECK(__i < __n && __value.key == __expected[__i].key && __value.tag == __expected[__i].tag);
+        __last = __it;
+    }
+    CHECK(__i == __n && FWL_size(&__list) == __n);
+    CHECK(FWL_rbegin(&__list) == __last);
+    CHECK(FWL_empty(&__src) && FWL_size(&__src) == 0 && FWL_begin(&__src) == NULL);
+
+    /* Both lists stay usable, finish included. */
+    FWL_push_back(struct Pair, &__list, {.key = -1, .tag = -1});
+    CHECK(FWL_cast(struct Pair, FWL_rbegin(&__list)).key == -1);
+    FWL_push_back(struct Pair, &__src, {.key = -2, .tag = -2});
+    CHECK(FWL_size(&__src) == 1 && FWL_cast(struct Pair, FWL_rbegin(&__src)).key == -2);
+    FWL_clear(&__list);
+    FWL_clear(&__src);
+}
+
+static void run_all(Forward_List (*__make)(size_t))
+{
+    static const size_t __sizes[][2] = {{0, 0}, {0, 7}, {7, 0}, {1, 1}, {40, 40}, {300, 17}, {17, 300}, {500, 600}};
+    for (int __op = MERGE; __op <= DIFFERENCE; ++__op)
+    {
+        for (size_t __s = 0; __s < sizeof(__sizes) / sizeof(__sizes[0]); ++__s)
+        {
+            for (int __seed = 0; __seed < 4; ++__seed)
+            {
+                run(__make(sizeof(struct Pair)), __make(sizeof(struct Pair)), (enum Operation) __op,
+                    __sizes[__s][0], __sizes[__s][1], __seed);
+            }
+        }
+    }
+}
+
+/* The std semantics on a small case, spelled out. */
+static void check_duplicates(void)
+{
+    Forward_List __list = FWL_init(int, {1, 1, 2, 3, 3, 3, 5});
+    Forward_List __src = FWL_init(int, {1, 2, 2, 3, 4, 6, 6});
+    FWL_set_union(&__list, &__src, greater_int);
+    CHECK(holds(&__list, (const int[]) {1, 1, 2, 2, 3, 3, 3, 4, 5, 6, 6}, 11) && FWL_empty(&__src));
+    FWL_clear(&__list);
+
+    __list = FWL_init(int, {1, 1, 2, 3, 3, 3, 5});
+    __src = FWL_init(int, {1, 2, 2, 3, 4, 6, 6});
+    FWL_set_intersection(&__list, &__src, greater_int);
+    CHECK(holds(&__list, (const int[]) {1, 2, 3}, 3) && FWL_empty(&__src));
+    FWL_clear(&__list);
+
+    __list = FWL_init(int, {1, 1, 2, 3, 3, 3, 5});
+    __src = FWL_init(int, {1, 2, 2, 3, 4, 6, 6});
+    FWL_set_difference(&__list, &__src, greater_int);
+    CHECK(holds(&__list, (const int[]) {1, 3, 3, 5}, 4) && FWL_empty(&__src));
+    FWL_clear(&__list);
+}
+
+/* Arena nodes cannot change lists, nor can nodes between allocators. */
+static void merge_arenas(void* __ctx)
+{
+    Forward_List __list = FWL_Init_arena(sizeof(int), 0);
+    Forward_List __src = FWL_Init_arena(sizeof(int), 0);
+    (void) __ctx;
+    FWL_push_back(int, &__list, 1);
+    FWL_push_back(int, &__src, 2);
+    FWL_merge(&__list, &__src, greater_int);
+}
+
+static void union_arenas(void* __ctx)
+{
+    Forward_List __list = FWL_Init_arena(sizeof(int), 0);
+    Forward_List __src = FWL_Init_arena(sizeof(int), 0);
+    (void) __ctx;
+    FWL_push_back(int, &__list, 1);
+    FWL_push_back(int, &__src, 2);
+    FWL_set_union(&__list, &__src, greater_int);
+}
+
+static void difference_mixed(void* __ctx)
+{
+    Forward_List __list = FWL_Init(sizeof(int));
+    Forward_List __src = FWL_Init_pooled(sizeof(int));
+    (void) __ctx;
+    FWL_push_back(int, &__list, 1);
+    FWL_push_back(int, &__src, 2);
+    FWL_set_difference(&__list, &__src, greater_int);
+}
+
+int main(void)
+{
+    check_duplicates();
+    run_all(FWL_Init);
+    run_all(FWL_Init_pooled);
+    check_exits(merge_arenas, NULL, "FWL_merge() : incompatible node allocators");
+    check_exits(union_arenas, NULL, "FWL_set_union() : incompatible node allocators");
+    check_exits(difference_mixed, NULL, "FWL_set_difference() : incompatible node allocators");
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "../include/forward_list_set.h"
+#include "../include/forward_list_epoch.h"
+#include "test_check.h"
+
+/*
+ * WRITERS threads insert and erase keys of [0, RANGE) at random while
+ * READERS threads look keys up. Keys of [RANGE, 2 * RANGE) are inserted
+ * first and never erased, so readers must always find them, and
+ * negative keys must never be found. In the end the set must be sorted,
+ * unmarked, and hold as many keys as the writers inserted net.
+ */
+#define WRITERS 4
+#define READERS 4
+#define OPERATIONS 100000
+#define RANGE 512
+
+static Forward_List_Set set;
+static atomic_long net;
+static atomic_int writing;
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const int*) __x > *(const int*) __y;
+}
+
+static void* write_keys(void* __arg)
+{
+    unsigned __x = (unsigned) (uintptr_t) __arg * 2654435761u + 1;
+    long __net = 0;
+    for (int __i = 0; __i < OPERATIONS; ++__i)
+    {
+        __x = __x * 1103515245u + 12345u;
+        int __key = (int) (__x >> 8) % RANGE;
+        if(__x & 0x10000)
+        {
+            __net += FWLS_insert(int, &set, __key);
+        }
+        else
+        {
+            __net -= FWLS_erase(int, &set, __key);
+        }
+    }
+    atomic_fetch_add(&net, __net);
+    atomic_fetch_sub(&writing, 1);
+    return NULL;
+}
+
+static void* read_keys(void* __arg)
+{
+    (void) __arg;
+    for (int __i = 0; atomic_load(&writing) > 0; ++__i)
+    {
+        CHECK(FWLS_contains(int, &set, RANGE + __i % RANGE));
+        CHECK(!FWLS_contains(int, &set, -1 - __i % RANGE));
+        FWLS_contains(int, &set, __i % RANGE);
+    }
+    return NULL;
+}
+
+int main(void)
+{
+    FWLS_Init(&set, sizeof(int), greater);
+    for (int __key = 2 * RANGE - 1; __key >= RANGE; --__key)
+    {
+        CHECK(FWLS_insert(int, &set, __key));
+    }
+    CHECK(!FWLS_insert(int, &set, RANGE));
+    atomic_store(&writing, WRITERS);
+
+    pthread_t __threads[WRITERS + READERS];
+    for (long __i = 0; __i < WRITERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[__i], NULL, write_keys, (void*) __i) == 0);
+    }
+    for (long __i = 0; __i < READERS; ++__i)
+    {
+        CHECK(pthread_create(&__threads[WRITERS + __i], NULL, read_keys, NULL) == 0);
+    }
+    for (int __i = 0; __i < WRITERS + READERS; ++__i)
+    {
+        pthread_join(__threads[__i], NULL);
+    }
+
+    size_t __linked = 0;
+    int __previous = -1;
+    for (Forward_List_Node* __it = set.start; __it; __it = __it->next, ++__linked)
+    {
+        CHECK(((uintptr_t) __it->next & 1) == 0);
+        CHECK(*(int*) __it->storage > __previous);
+        __previous = *(int*) __it->storage;
+    }
+    CHECK(__linked == (size_t) (RANGE + atomic_load(&net)));
+    CHECK(FWLS_size(&set) == __linked);
+
+    FWLS_clear(&set);
+    CHECK(FWLS_empty(&set));
+    FWL_epoch_flush();
+    return 0;
+}
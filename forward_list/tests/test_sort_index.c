@@ -0,0 +1,101 @@
+#include <stdint.h>
+#include "../include/forward_list.h"
+#include "test_check.h"
+
+static int greater(const void* __x, const void* __y)
+{
+    return *(const int*) __x > *(const int*) __y;
+}
+
+static uint64_t prefix(const void* __value)
+{
+    return (uint64_t) *(const int*) __value;
+}
+
+/* Every sort of the list, each must leave the indexes usable. */
+static void sort_prefixed(Forward_List* __list) { FWL_sort_prefixed(__list, greater, prefix); }
+static void sort_merge(Forward_List* __list)    { FWL_sort(__list, greater); }
+static void sort_parallel(Forward_List* __list) { FWL_sort_parallel(__list, greater, 4); }
+static void sort_radix(Forward_List* __list)    { FWL_sort_radix(__list, 0, sizeof(int), FWL_KEY_SIGNED); }
+
+static Forward_List make_reversed(int __n)
+{
+    Forward_List __list = FWL_Init(sizeof(int));
+    for (int __i = __n; __i >= 1; --__i)
+    {
+        FWL_push_back(int, &__list, __i);
+    }
+    return __list;
+}
+
+/* Positional index, enabled before the sort. */
+static void check_index(void (*__sort)(Forward_List *), size_t __stride)
+{
+    Forward_List __list = make_reversed(5);
+    FWL_enable_index(&__list, __stride);
+    CHECK(FWL_cast(int, FWL_at(&__list, 0)) == 5);
+    __sort(&__list);
+    for (int __i = 0; __i < 5; ++__i)
+    {
+        CHECK(FWL_cast(int, FWL_at(&__list, __i)) == __i + 1);
+    }
+    FWL_pop_back(&__list);
+    CHECK(FWL_size(&__list) == 4);
+    CHECK(FWL_back(int, &__list) == 4);
+    int __expected = 1;
+    for (FWL_iterator __it = FWL_begin(&__list); __it; __it = __it->next, ++__expected)
+    {
+        CHECK(FWL_cast(int, __it) == __expected);
+    }
+    CHECK(__expected == 5);
+    FWL_clear(&__list);
+}
+
+/*
+ * Skip list built over a sorted list whose values are then rewritten in
+ * place, so that sorting again moves every node.
+ */
+static void check_skip(void (*__sort)(Forward_List *))
+{
+    Forward_List __list = FWL_Init(sizeof(int));
+    for (int __i = 1; __i <= 64; ++__i)
+    {
+        FWL_push_back(int, &__list, __i);
+    }
+    FWL_enable_sorted(&__list, greater);
+    CHECK(FWL_find_sorted(int, &__list, 10) != NULL);
+    int __value = 64;
+    for (FWL_iterator __it = FWL_begin(&__list); __it; __it = __it->next)
+    {
+        FWL_cast(int, __it) = __value--;
+    }
+    __sort(&__list);
+    for (int __i = 1; __i <= 64; ++__i)
+    {
+        FWL_iterator __it = FWL_find_sorted(int, &__list, __i);
+        CHECK(__it && FWL_cast(int, __it) == __i);
+    }
+    FWL_insert_sorted(int, &__list, 65);
+    FWL_insert_sorted(int, &__list, 0);
+    CHECK(FWL_front(int, &__list) == 0);
+    CHECK(FWL_back(int, &__list) == 65);
+    int __expected = 0;
+    for (FWL_iterator __it = FWL_begin(&__list); __it; __it = __it->next, ++__expected)
+    {
+        CHECK(FWL_cast(int, __it) == __expected);
+    }
+    CHECK(__expected == 66);
+    FWL_clear(&__list);
+}
+
+int main(void)
+{
+    void (*__sorts[])(Forward_List *) = {sort_prefixed, sort_merge, sort_parallel, sort_radix};
+    for (size_t __i = 0; __i < sizeof(__sorts) / sizeof(__sorts[0]); ++__i)
+    {
+        check_index(__sorts[__i], 1);
+        check_index(__sorts[__i], 2);
+        check_skip(__sorts[__i]);
+    }
+    return 0;
+}
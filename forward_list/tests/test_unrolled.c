@@ -0,0 +1,301 @@
+#include <string.h>
+#include "../include/forward_list_unrolled.h"
+#include "test_check.h"
+
+static int is_odd(const void* __x)
+{
+    return *(const int*) __x & 1;
+}
+
+static int equal(const void* __x, const void* __y)
+{
+    return *(const int*) __x == *(const int*) __y;
+}
+
+static size_t count_nodes(Forward_List_Unrolled* __list)
+{
+    size_t __n = 0;
+    for (Forward_List_Unrolled_Node* __node = __list->start; __node; __node = __node->next)
+    {
+        ++__n;
+    }
+    return __n;
+}
+
+/*
+ * The list holds exactly __expected, no node is empty or overfull,
+ * finish is the last node and FWLU_rbegin() the last element.
+ */
+static void check_list(Forward_List_Unrolled* __list, const int* __expected, size_t __n)
+{
+    size_t __i = 0;
+    for (FWLU_iterator __it = FWLU_begin(__list); !FWLU_is_end(__it); __it = FWLU_next(__it), ++__i)
+    {
+        CHECK(__i < __n && FWLU_cast(int, __it) == __expected[__i]);
+    }
+    CHECK(__i == __n && FWLU_size(__list) == __n);
+    Forward_List_Unrolled_Node* __last = NULL;
+    for (Forward_List_Unrolled_Node* __node = __list->start; __node; __node = __node->next)
+    {
+        CHECK(__node->used > 0 && __node->used <= __list->capacity);
+        __last = __node;
+    }
+    CHECK(__list->finish == __last);
+    FWLU_iterator __rbegin = FWLU_rbegin(__list);
+    if(__n)
+    {
+        CHECK(__rbegin.node == __last && FWLU_cast(int, __rbegin) == __expected[__n - 1]);
+    }
+    else
+    {
+        CHECK(__rbegin.node == FWLU_before_begin(__list).node);
+    }
+}
+
+/* Returns an iterator to the element at __pos, or before-begin for -1. */
+static FWLU_iterator at(Forward_List_Unrolled* __list, long __pos)
+{
+    FWLU_iterator __it = FWLU_before_begin(__list);
+    for (long __i = -1; __i < __pos; ++__i)
+    {
+        __it = FWLU_next(__it);
+    }
+    return __it;
+}
+
+static void model_insert(int* __model, size_t* __n, size_t __pos, int __value)
+{
+    memmove(__model + __pos + 1, __model + __pos, (*__n - __pos) * sizeof(int));
+    __model[__pos] = __value;
+    ++*__n;
+}
+
+static void model_erase(int* __model, size_t* __n, size_t __pos, size_t __k)
+{
+    memmove(__model + __pos, __model + __pos + __k, (*__n - __pos - __k) * sizeof(int));
+    *__n -= __k;
+}
+
+/* Stepping from before the first element has to land on the first element. */
+static void check_before_begin(void)
+{
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(int));
+    CHECK(FWLU_is_end(FWLU_next(FWLU_before_begin(&__list))));
+
+    __list = FWLU_init(int, {1, 2, 3});
+    FWLU_iterator __it = FWLU_next(FWLU_before_begin(&__list));
+    CHECK(__it.node == FWLU_begin(&__list).node && __it.index == 0);
+    CHECK(FWLU_cast(int, __it) == 1);
+
+    /* Walk before each element and insert in front of it. */
+    FWLU_iterator __before = FWLU_before_begin(&__list);
+    for (int __i = 0; __i < 3; ++__i)
+    {
+        __before = FWLU_insert_after(int, &__list, __before, -1);
+        __before = FWLU_next(__before);
+    }
+    const int __expected[] = {-1, 1, -1, 2, -1, 3};
+    int __i = 0;
+    for (FWLU_iterator __it = FWLU_begin(&__list); !FWLU_is_end(__it); __it = FWLU_next(__it), ++__i)
+    {
+        CHECK(FWLU_cast(int, __it) == __expected[__i]);
+    }
+    CHECK(__i == 6 && FWLU_size(&__list) == 6);
+
+    /* Pop everything through the iterator reached from before-begin. */
+    __before = FWLU_before_begin(&__list);
+    __it = FWLU_next(__before);
+    CHECK(FWLU_cast(int, __it) == -1);
+    while(!FWLU_empty(&__list))
+    {
+        FWLU_pop_after(&__list, __before);
+    }
+    CHECK(FWLU_size(&__list) == 0);
+    CHECK(FWLU_rbegin(&__list).node == FWLU_before_begin(&__list).node);
+    FWLU_clear(&__list);
+}
+
+/* Inserting into a full node splits it in two half full nodes. */
+static void check_split(void)
+{
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(int));
+    int __model[256];
+    size_t __n = 0;
+    for (int __i = 0; __i < (int) __list.capacity; ++__i)
+    {
+        FWLU_push_back(int, &__list, __i);
+        __model[__n++] = __i;
+    }
+    CHECK(count_nodes(&__list) == 1);
+    check_list(&__list, __model, __n);
+
+    FWLU_iterator __it = FWLU_insert_after(int, &__list, at(&__list, 2), 100);
+    CHECK(FWLU_cast(int, __it) == 100);
+    model_insert(__model, &__n, 3, 100);
+    CHECK(count_nodes(&__list) == 2);
+    CHECK(__list.start->used == __list.capacity / 2 + 1);
+    check_list(&__list, __model, __n);
+
+    /* Splitting again in the second half, the new element lands in the tail. */
+    for (int __i = 0; __list.finish->used < __list.capacity; ++__i)
+    {
+        FWLU_push_back(int, &__list, 200 + __i);
+        __model[__n++] = 200 + __i;
+    }
+    __it = FWLU_insert_after(int, &__list, at(&__list, (long) __n - 3), 300);
+    CHECK(FWLU_cast(int, __it) == 300);
+    model_insert(__model, &__n, __n - 2, 300);
+    check_list(&__list, __model, __n);
+
+    FWLU_push_front(int, &__list, -1);
+    model_insert(__model, &__n, 0, -1);
+    check_list(&__list, __model, __n);
+    FWLU_clear(&__list);
+    check_list(&__list, __model, 0);
+}
+
+/* Erasing leaves no underfull pair of neighbours that fits in one node. */
+static void check_erase(void)
+{
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(int));
+    int __model[256];
+    size_t __n = 0;
+    for (int __i = 0; __i < 4 * (int) __list.capacity; ++__i)
+    {
+        FWLU_push_back(int, &__list, __i);
+        __model[__n++] = __i;
+    }
+    CHECK(count_nodes(&__list) == 4);
+
+    /* Empty most of the second node, neither neighbour has room for the rest. */
+    size_t __cap = __list.capacity;
+    FWLU_iterator __it = FWLU_erase_after(&__list, at(&__list, (long) __cap), __cap - 3);
+    model_erase(__model, &__n, __cap + 1, __cap - 3);
+    CHECK(FWLU_cast(int, __it) == __model[__cap + 1]);
+    CHECK(count_nodes(&__list) == 4);
+    check_list(&__list, __model, __n);
+
+    /* Erasing the head of the third node lets the second one absorb it. */
+    __it = FWLU_erase_after(&__list, at(&__list, (long) __cap + 2), 3);
+    model_erase(__model, &__n, __cap + 3, 3);
+    CHECK(FWLU_cast(int, __it) == __model[__cap + 3]);
+    CHECK(count_nodes(&__list) == 3);
+    check_list(&__list, __model, __n);
+
+    /* Popping one at a time from the middle keeps merging. */
+    while(__n > __cap)
+    {
+        __it = FWLU_pop_after(&__list, at(&__list, 4));
+        model_erase(__model, &__n, 5, 1);
+        CHECK(FWLU_cast(int, __it) == __model[5]);
+        check_list(&__list, __model, __n);
+    }
+    CHECK(count_nodes(&__list) <= 2);
+
+    /* Erasing across nodes up to the end. */
+    __it = FWLU_erase_after(&__list, at(&__list, 1), __n);
+    CHECK(FWLU_is_end(__it));
+    check_list(&__list, __model, 2);
+    __n = 2;
+    FWLU_pop_front(&__list);
+    FWLU_pop_after(&__list, FWLU_before_begin(&__list));
+    check_list(&__list, __model, 0);
+}
+
+/* A range moved out of a list leaves the rest of it in order and counted. */
+static void check_splice_range(void)
+{
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(int));
+    Forward_List_Unrolled __src = FWLU_Init(sizeof(int));
+    int __model[256], __src_model[256];
+    size_t __n = 0, __src_n = 0;
+    for (int __i = 0; __i < 20; ++__i)
+    {
+        FWLU_push_back(int, &__list, __i);
+        __model[__n++] = __i;
+    }
+    for (int __i = 0; __i < 100; ++__i)
+    {
+        FWLU_push_back(int, &__src, 1000 + __i);
+        __src_model[__src_n++] = 1000 + __i;
+    }
+
+    FWLU_splice_after_range(&__list, at(&__list, 9), &__src, at(&__src, 9), 30);
+    memmove(__model + 40, __model + 10, 10 * sizeof(int));
+    memcpy(__model + 10, __src_model + 10, 30 * sizeof(int));
+    __n += 30;
+    model_erase(__src_model, &__src_n, 10, 30);
+    check_list(&__list, __model, __n);
+    check_list(&__src, __src_model, __src_n);
+
+    /* The tail of the source, to the end of the destination. */
+    FWLU_splice_after_range(&__list, FWLU_rbegin(&__list), &__src, at(&__src, 49), 1000);
+    memcpy(__model + __n, __src_model + 50, 20 * sizeof(int));
+    __n += 20;
+    __src_n = 50;
+    check_list(&__list, __model, __n);
+    check_list(&__src, __src_model, __src_n);
+
+    /* The head of the source, to the front. */
+    FWLU_splice_after_range(&__list, FWLU_before_begin(&__list), &__src, FWLU_before_begin(&__src), 5);
+    memmove(__model + 5, __model, __n * sizeof(int));
+    memcpy(__model, __src_model, 5 * sizeof(int));
+    __n += 5;
+    model_erase(__src_model, &__src_n, 0, 5);
+    check_list(&__list, __model, __n);
+    check_list(&__src, __src_model, __src_n);
+
+    FWLU_splice_after_list(&__list, at(&__list, 0), &__src);
+    memmove(__model + 1 + __src_n, __model + 1, (__n - 1) * sizeof(int));
+    memcpy(__model + 1, __src_model, __src_n * sizeof(int));
+    __n += __src_n;
+    check_list(&__list, __model, __n);
+    check_list(&__src, __src_model, 0);
+    FWLU_clear(&__list);
+}
+
+static void check_filters(void)
+{
+    Forward_List_Unrolled __list = FWLU_Init(sizeof(int));
+    int __model[256];
+    size_t __n = 0;
+    for (int __i = 0; __i < 200; ++__i)
+    {
+        FWLU_push_back(int, &__list, __i / 3);
+    }
+    FWLU_unique(&__list, equal);
+    for (int __i = 0; __i < 67; ++__i)
+    {
+        __model[__n++] = __i;
+    }
+    check_list(&__list, __model, __n);
+
+    FWLU_remove_if(&__list, is_odd);
+    __n = 0;
+    for (int __i = 0; __i < 67; __i += 2)
+    {
+        __model[__n++] = __i;
+    }
+    check_list(&__list, __model, __n);
+    CHECK(count_nodes(&__list) == (__n + __list.capacity - 1) / __list.capacity);
+
+    /* Odd values at both ends, the last node goes away. */
+    FWLU_push_front(int, &__list, 1);
+    FWLU_push_back(int, &__list, 3);
+    FWLU_remove_if(&__list, is_odd);
+    check_list(&__list, __model, __n);
+
+    FWLU_unique(&__list, equal);
+    check_list(&__list, __model, __n);
+    FWLU_clear(&__list);
+}
+
+int main(void)
+{
+    check_before_begin();
+    check_split();
+    check_erase();
+    check_splice_range();
+    check_filters();
+    return 0;
+}